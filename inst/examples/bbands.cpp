@@ -27,6 +27,8 @@ Rcpp::List bbands(
   Processor bt( timeFrame );
   // set options
   bt.SetOptions( options );
+  // record candles history straight to R vectors or keep summary only
+  if( not fast ) bt.RecordHistoryToR(); else bt.RecordSummaryOnly();
   // if trading hours not set then isTradingHours set true
   bool isTradingHours = not bt.IsTradingHoursSet();
 
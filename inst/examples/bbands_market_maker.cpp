@@ -27,6 +27,8 @@ Rcpp::List bbands_market_maker(
   Processor bt( timeFrame );
   // set options
   bt.SetOptions( options );
+  // record candles history straight to R vectors
+  if( not fast ) bt.RecordHistoryToR();
   // if trading hours not set then isTradingHours set true
   bool isTradingHours = not bt.IsTradingHoursSet();
 
@@ -48,7 +50,7 @@ Rcpp::List bbands_market_maker(
   std::function<void()> quoteLongExit = [&]() {
 
     // quote sell with current levelLongExit price
-    sell = new Order( OrderSide::SELL, OrderType::LIMIT, levelLongExit, "close long", idTrade );
+    sell = bt.NewOrder( OrderSide::SELL, OrderType::LIMIT, levelLongExit, "close long", idTrade );
     // attach events to order:
     //   when long position closed ( sold ) exit logic triggered
     sell->onExecuted  = onTradeExit;
@@ -63,7 +65,7 @@ Rcpp::List bbands_market_maker(
   std::function<void()> quoteLongEnter = [&]() {
 
     // quote buy with current levelLongEnter price
-    buy = new Order( OrderSide::BUY, OrderType::LIMIT, levelLongEnter, "long", idTrade );
+    buy = bt.NewOrder( OrderSide::BUY, OrderType::LIMIT, levelLongEnter, "long", idTrade );
     // attach events to order:
     //   when long opening order executed
     buy->onExecuted = [&]() {
@@ -92,7 +94,7 @@ Rcpp::List bbands_market_maker(
   std::function<void()> quoteShortExit = [&]() {
 
     // quote buy with current levelShortExit price
-    buy = new Order( OrderSide::BUY, OrderType::LIMIT, levelShortExit, "close short", idTrade );
+    buy = bt.NewOrder( OrderSide::BUY, OrderType::LIMIT, levelShortExit, "close short", idTrade );
     // attach events to order:
     //   when short position closed ( bought ) exit logic triggered
     buy->onExecuted  = onTradeExit;
@@ -106,7 +108,7 @@ Rcpp::List bbands_market_maker(
   // short opener logic
   std::function<void()> quoteShortEnter = [&]() {
     // quote sell with current levelShortEnter price
-    sell = new Order( OrderSide::SELL, OrderType::LIMIT, levelShortEnter, "short", idTrade );
+    sell = bt.NewOrder( OrderSide::SELL, OrderType::LIMIT, levelShortEnter, "short", idTrade );
     // attach events to order:
     //   when short opening order executed
     sell->onExecuted = [&]() {
@@ -160,7 +162,7 @@ Rcpp::List bbands_market_maker(
       //   when cancelled
       buy->onCancelled = [&]() {
         // create market order to close short position
-        Order* buy = new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "close short (EOD)", idTrade );
+        Order* buy = bt.NewOrder( OrderSide::BUY, OrderType::MARKET, NA_REAL, "close short (EOD)", idTrade );
         // attach events to order:
         //   when market order executed
         buy->onExecuted = [&]() {
@@ -189,7 +191,7 @@ Rcpp::List bbands_market_maker(
       //   when cancelled
       sell->onCancelled = [&]() {
         // create market order to close short position
-        Order* sell = new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "close long (EOD)", idTrade );
+        Order* sell = bt.NewOrder( OrderSide::SELL, OrderType::MARKET, NA_REAL, "close long (EOD)", idTrade );
         // attach events to order:
         //   when market order executed
         sell->onExecuted = [&]() {
@@ -225,7 +227,7 @@ Rcpp::List bbands_market_maker(
         // send long opener cancel request to exchange
         buy->Cancel();
         // create market order to close short position
-        Order* buy = new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "close short (EOD)", idTrade );
+        Order* buy = bt.NewOrder( OrderSide::BUY, OrderType::MARKET, NA_REAL, "close short (EOD)", idTrade );
         // attach events to order:
         //   when market order executed
         buy->onExecuted = [&]() {
@@ -257,7 +259,7 @@ Rcpp::List bbands_market_maker(
         // send short opener cancel request to exchange
         sell->Cancel();
         // create market order to close long position
-        Order* sell = new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "close long (EOD)", idTrade );
+        Order* sell = bt.NewOrder( OrderSide::SELL, OrderType::MARKET, NA_REAL, "close long (EOD)", idTrade );
         // attach events to order:
         //   when market order executed
         sell->onExecuted = [&]() {
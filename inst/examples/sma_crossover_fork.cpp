@@ -0,0 +1,136 @@
+// [[Rcpp::plugins(cpp11)]]
+// [[Rcpp::depends(QuantTools)]]
+#include <Rcpp.h>
+#include "BackTest.h"
+
+// strategy state is kept together so it can be copied along with forked processor
+class SmaCrossover {
+
+  enum class ProcessingState{ LONG, FLAT, SHORT };
+
+  Processor* bt;
+  Sma smaFast;
+  Sma smaSlow;
+  Crossover crossover;
+  ProcessingState state = ProcessingState::FLAT;
+  int idTrade = 1;
+  bool isTradingHours;
+
+public:
+
+  SmaCrossover( const Sma& smaFast, const Sma& smaSlow ) : smaFast( smaFast ), smaSlow( smaSlow ) {}
+
+  // callbacks capture this strategy so they are set on every fork
+  void Attach( Processor& bt ) {
+
+    this->bt = &bt;
+
+    // if trading hours not set then isTradingHours set true
+    isTradingHours = not bt.IsTradingHoursSet();
+
+    bt.onMarketOpen  = [this]() { isTradingHours = true; };
+    bt.onMarketClose = [this]() {
+      // forbid trading and close open positions
+      isTradingHours = false;
+      if( state == ProcessingState::SHORT ) {
+        this->bt->SendOrder( new Order( OrderSide::BUY , OrderType::MARKET, NA_REAL, "close short (EOD)", idTrade++ ) );
+      }
+      if( state == ProcessingState::LONG ) {
+        this->bt->SendOrder( new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "close long (EOD)" , idTrade++ ) );
+      }
+      state = ProcessingState::FLAT;
+    };
+    bt.onCandle = [this]( Candle candle ) { OnCandle( candle ); };
+
+  }
+
+  void OnCandle( const Candle& candle ) {
+
+    smaSlow.Add( candle.close );
+    smaFast.Add( candle.close );
+
+    if( not smaFast.IsFormed() or not smaSlow.IsFormed() ) return;
+
+    crossover.Add( std::pair< double, double >( smaFast.GetValue(), smaSlow.GetValue() ) );
+
+    if( not bt->CanTrade()  ) return;
+    if( not isTradingHours ) return;
+
+    if( crossover.IsAbove() and state != ProcessingState::LONG ) {
+      if( state == ProcessingState::FLAT ) {
+        bt->SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "long", idTrade ) );
+      }
+      if( state == ProcessingState::SHORT ) {
+        bt->SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "close short"  , idTrade++ ) );
+        bt->SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "reverse short", idTrade   ) );
+      }
+      state = ProcessingState::LONG;
+    }
+    if( crossover.IsBelow() and state != ProcessingState::SHORT ) {
+      if( state == ProcessingState::FLAT ) {
+        bt->SendOrder( new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "short", idTrade ) );
+      }
+      if( state == ProcessingState::LONG ) {
+        bt->SendOrder( new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "close long"  , idTrade++ ) );
+        bt->SendOrder( new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "reverse long", idTrade   ) );
+      }
+      state = ProcessingState::SHORT;
+    }
+
+  }
+
+};
+
+// [[Rcpp::export]]
+Rcpp::List sma_crossover_fork(
+    Rcpp::DataFrame ticks,
+    Rcpp::DataFrame parameters,
+    Rcpp::List options,
+    int timeframe,
+    int n_warm_up
+  ) {
+
+  Ticks data( ticks );
+  if( n_warm_up < 0 or n_warm_up > (int)data.size() ) throw std::invalid_argument( "n_warm_up must be in [0, number of ticks]" );
+
+  Rcpp::IntegerVector fastPeriods = parameters[ "period_fast" ];
+  Rcpp::IntegerVector slowPeriods = parameters[ "period_slow" ];
+
+  // warm up indicators of all periods once
+  std::map< int, Sma > smas;
+  for( auto period: fastPeriods ) smas.emplace( period, Sma( period ) );
+  for( auto period: slowPeriods ) smas.emplace( period, Sma( period ) );
+  for( auto& sma: smas ) sma.second.SetHistoryMode( HistoryMode::NONE );
+
+  Processor bt( timeframe );
+  bt.SetOptions( options );
+  // forks inherit summary only mode
+  bt.RecordSummaryOnly();
+  bt.onCandle = [&]( Candle candle ) { for( auto& sma: smas ) sma.second.Add( candle.close ); };
+  bt.FeedChunk( data.Slice( 0, n_warm_up ) );
+
+  // every parameters row continues from the end of warm up
+  std::vector< Statistics > statistics;
+
+  for( int i = 0; i < parameters.nrows(); i++ ) {
+
+    std::unique_ptr< Processor > fork( bt.Fork() );
+
+    SmaCrossover strategy( smas.at( fastPeriods[i] ), smas.at( slowPeriods[i] ) );
+    strategy.Attach( *fork );
+
+    fork->Feed( data.Slice( n_warm_up, data.size() ) );
+    statistics.push_back( fork->GetStatistics() );
+
+  }
+
+  std::vector< const Statistics* > summaries;
+  for( auto& s: statistics ) summaries.push_back( &s );
+
+  Rcpp::List summary = ListBuilder().AsDataTable()
+    .Add( parameters )
+    .Add( Statistics::GetSummary( summaries ) );
+
+  return summary;
+
+}
@@ -0,0 +1,127 @@
+// [[Rcpp::plugins(cpp11)]]
+// [[Rcpp::depends(QuantTools)]]
+#include <Rcpp.h>
+#include "BackTest.h"
+
+// [[Rcpp::export]]
+Rcpp::List sma_crossover_resume(
+    Rcpp::DataFrame ticks,
+    Rcpp::List parameters,
+    Rcpp::List options,
+    Rcpp::Nullable< Rcpp::RawVector > snapshot = R_NilValue
+  ) {
+
+  int    fastPeriod = parameters["period_fast" ];
+  int    slowPeriod = parameters["period_slow" ];
+  int    timeFrame  = parameters["timeframe"   ];
+
+  // define strategy states
+  enum class ProcessingState{ LONG, FLAT, SHORT };
+  ProcessingState state = ProcessingState::FLAT;
+  int idTrade = 1;
+
+  // initialize indicators
+  Sma smaFast( fastPeriod );
+  Sma smaSlow( slowPeriod );
+  Crossover crossover;
+
+  // initialize Processor
+  Processor bt( timeFrame );
+  // set options
+  bt.SetOptions( options );
+
+  // if trading hours not set then isTradingHours set true
+  bool isTradingHours = not bt.IsTradingHoursSet();
+
+  // processor, indicators and strategy variables are saved and loaded in the same order
+  auto serialize = [&]( Snapshot& snapshot ) {
+
+    bt       .Serialize( snapshot );
+    smaFast  .Serialize( snapshot );
+    smaSlow  .Serialize( snapshot );
+    crossover.Serialize( snapshot );
+
+    snapshot.Field( state          );
+    snapshot.Field( idTrade        );
+    snapshot.Field( isTradingHours );
+
+  };
+
+  // continue from previous run if its snapshot is given
+  if( snapshot.isNotNull() ) {
+
+    Snapshot previous( Rcpp::as< Rcpp::RawVector >( snapshot ) );
+    serialize( previous );
+
+  }
+
+  // callbacks are not saved so they are set on every run
+  bt.onMarketOpen  = [&]() {
+    // allow trading
+    isTradingHours = true;
+
+  };
+  bt.onMarketClose = [&]() {
+    // forbid trading and close open positions
+    isTradingHours = false;
+    if( state == ProcessingState::SHORT ) {
+      bt.SendOrder( new Order( OrderSide::BUY , OrderType::MARKET, NA_REAL, "close short (EOD)", idTrade++ ) );
+    }
+    if( state == ProcessingState::LONG ) {
+      bt.SendOrder( new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "close long (EOD)" , idTrade++ ) );
+    }
+    state = ProcessingState::FLAT;
+
+  };
+
+  // define what to do when new candle is formed
+  bt.onCandle = [&]( Candle candle ) {
+
+    smaSlow.Add( candle.close );
+    smaFast.Add( candle.close );
+
+    if( not smaFast.IsFormed() or not smaSlow.IsFormed() ) return;
+
+    crossover.Add( std::pair< double, double >( smaFast.GetValue(), smaSlow.GetValue() ) );
+
+    if( not bt.CanTrade()  ) return;
+    if( not isTradingHours ) return;
+
+    if( crossover.IsAbove() and state != ProcessingState::LONG ) {
+      if( state == ProcessingState::FLAT ) {
+        bt.SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "long", idTrade ) );
+      }
+      if( state == ProcessingState::SHORT ) {
+        bt.SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "close short"  , idTrade++ ) );
+        bt.SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "reverse short", idTrade   ) );
+      }
+      state = ProcessingState::LONG;
+    }
+    if( crossover.IsBelow() and state != ProcessingState::SHORT ) {
+      if( state == ProcessingState::FLAT ) {
+        bt.SendOrder( new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "short", idTrade ) );
+      }
+      if( state == ProcessingState::LONG ) {
+        bt.SendOrder( new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "close long"  , idTrade++ ) );
+        bt.SendOrder( new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "reverse long", idTrade   ) );
+      }
+      state = ProcessingState::SHORT;
+    }
+
+  };
+
+  // feed new ticks only, statistics are not finalized yet
+  bt.FeedChunk( ticks );
+
+  // save state before statistics are finalized so next run can continue from here
+  Snapshot next;
+  serialize( next );
+
+  bt.Finalize();
+
+  return ListBuilder()
+    .Add( "summary" , bt.GetSummary() )
+    .Add( "trades"  , bt.GetTrades()  )
+    .Add( "snapshot", next.Get()      );
+
+}
@@ -0,0 +1,99 @@
+// [[Rcpp::plugins(cpp11)]]
+// [[Rcpp::depends(QuantTools)]]
+#include <Rcpp.h>
+#include "BackTest.h"
+
+// [[Rcpp::export]]
+Rcpp::List sma_crossover_sweep(
+    Rcpp::DataFrame ticks,
+    Rcpp::DataFrame parameters,
+    Rcpp::List options,
+    int n_threads = 0
+  ) {
+
+  // decode ticks and configure processors once
+  Sweep sweep( ticks, parameters, options );
+
+  // strategy is run on worker threads so it must not use R objects
+  auto strategy = []( Processor& bt, const Sweep::Parameters& parameters, const Ticks& ticks ) {
+
+    int fastPeriod = parameters.at( "period_fast" );
+    int slowPeriod = parameters.at( "period_slow" );
+
+    // define strategy states
+    enum class ProcessingState{ LONG, FLAT, SHORT };
+    ProcessingState state = ProcessingState::FLAT;
+    int idTrade = 1;
+
+    // initialize indicators
+    Sma smaFast( fastPeriod );
+    Sma smaSlow( slowPeriod );
+    Crossover crossover;
+
+    // only current values are used so history is not recorded
+    smaFast  .SetHistoryMode( HistoryMode::NONE );
+    smaSlow  .SetHistoryMode( HistoryMode::NONE );
+    crossover.SetHistoryMode( HistoryMode::NONE );
+
+    // if trading hours not set then isTradingHours set true
+    bool isTradingHours = not bt.IsTradingHoursSet();
+
+    // define market open/close events
+    bt.onMarketOpen  = [&]() { isTradingHours = true; };
+    bt.onMarketClose = [&]() {
+      // forbid trading and close open positions
+      isTradingHours = false;
+      if( state == ProcessingState::SHORT ) {
+        bt.SendOrder( new Order( OrderSide::BUY , OrderType::MARKET, NA_REAL, "close short (EOD)", idTrade++ ) );
+      }
+      if( state == ProcessingState::LONG ) {
+        bt.SendOrder( new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "close long (EOD)" , idTrade++ ) );
+      }
+      state = ProcessingState::FLAT;
+    };
+
+    // define what to do when new candle is formed
+    bt.onCandle = [&]( Candle candle ) {
+
+      smaSlow.Add( candle.close );
+      smaFast.Add( candle.close );
+
+      if( not smaFast.IsFormed() or not smaSlow.IsFormed() ) return;
+
+      crossover.Add( std::pair< double, double >( smaFast.GetValue(), smaSlow.GetValue() ) );
+
+      if( not bt.CanTrade()  ) return;
+      if( not isTradingHours ) return;
+
+      if( crossover.IsAbove() and state != ProcessingState::LONG ) {
+        if( state == ProcessingState::FLAT ) {
+          bt.SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "long", idTrade ) );
+        }
+        if( state == ProcessingState::SHORT ) {
+          bt.SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "close short"  , idTrade++ ) );
+          bt.SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "reverse short", idTrade   ) );
+        }
+        state = ProcessingState::LONG;
+      }
+      if( crossover.IsBelow() and state != ProcessingState::SHORT ) {
+        if( state == ProcessingState::FLAT ) {
+          bt.SendOrder( new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "short", idTrade ) );
+        }
+        if( state == ProcessingState::LONG ) {
+          bt.SendOrder( new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "close long"  , idTrade++ ) );
+          bt.SendOrder( new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "reverse long", idTrade   ) );
+        }
+        state = ProcessingState::SHORT;
+      }
+
+    };
+
+    // run back test on tick data
+    bt.Feed( ticks );
+
+  };
+
+  // run all parameters combinations and return summaries
+  return sweep.Run( strategy, n_threads );
+
+}
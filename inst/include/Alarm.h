@@ -19,6 +19,8 @@
 #define ALARM_H
 
 #include "NPeriods.h"
+#include "Snapshot.h"
+#include <cmath>
 
 class Alarm {
 
@@ -67,6 +69,26 @@ public:
 
   double GetTime() { return time; }
 
+  // earliest time IsRinging may return true at, given it is called on every day after last call
+  double GetNextRingTime() {
+
+    if( not isSet ) return INFINITY;
+
+    double dayStart = (int)prevTime / nSecondsInDay * (double)nSecondsInDay;
+
+    return dayStart + ( wasRingingToday ? nSecondsInDay : 0 ) + time * nSecondsInHour;
+
+  }
+
+  void Serialize( Snapshot& snapshot ) {
+
+    snapshot.Field( time            );
+    snapshot.Field( prevTime        );
+    snapshot.Field( wasRingingToday );
+    snapshot.Field( isSet           );
+
+  }
+
 };
 
 #endif //ALARM_H
@@ -19,6 +19,8 @@
 #define BACKTEST_H
 
 #include "BackTest/Processor.h"
+#include "BackTest/Sweep.h"
+#include "BackTest/TickFile.h"
 #include "Indicators.h"
 
 #endif //BACKTEST_H
@@ -19,6 +19,7 @@
 #define CANDLE_H
 
 #include "Tick.h"
+#include "../Snapshot.h"
 
 class Candle {
 
@@ -86,32 +87,49 @@ public:
 
     id = tick.id;
 
-    if( not tick.system ) {
+    if( not tick.system ) Add( tick.price, tick.volume );
 
-      if( isEmpty ) {
+    return *this;
 
-        open   = tick.price;
-        high   = tick.price;
-        low    = tick.price;
-        close  = tick.price;
-        volume = tick.volume;
 
-        isEmpty = false;
+  }
 
-      } else {
+  // adds trade known to belong to this candle, used to aggregate ticks without checking candle time
+  void Add( double price, int volume ) {
 
-        close = tick.price;
-        volume += tick.volume;
+    if( isEmpty ) {
 
-        if( high < tick.price ) high = tick.price;
-        if( low  > tick.price ) low  = tick.price;
+      open   = price;
+      high   = price;
+      low    = price;
+      close  = price;
+      this->volume = volume;
 
-      }
+      isEmpty = false;
+
+    } else {
+
+      close = price;
+      this->volume += volume;
+
+      if( high < price ) high = price;
+      if( low  > price ) low  = price;
 
     }
 
-    return *this;
+  }
 
+  void Serialize( Snapshot& snapshot ) {
+
+    snapshot.Check( timeFrame );
+    snapshot.Field( id        );
+    snapshot.Field( open      );
+    snapshot.Field( high      );
+    snapshot.Field( low       );
+    snapshot.Field( close     );
+    snapshot.Field( time      );
+    snapshot.Field( volume    );
+    snapshot.Field( isEmpty   );
 
   }
 
@@ -18,6 +18,8 @@
 #ifndef COST_H
 #define COST_H
 
+#include "../Snapshot.h"
+
 class Cost {
 
 public:
@@ -33,6 +35,21 @@ public:
   double shortRel   = 0; // relative commission/refund per short volume
   double pointValue = 1; // absolute point value ( 1 for stocks )
 
+  void Serialize( Snapshot& snapshot ) {
+
+    snapshot.Field( cancel     );
+    snapshot.Field( order      );
+    snapshot.Field( tradeAbs   );
+    snapshot.Field( stockAbs   );
+    snapshot.Field( tradeRel   );
+    snapshot.Field( longAbs    );
+    snapshot.Field( longRel    );
+    snapshot.Field( shortAbs   );
+    snapshot.Field( shortRel   );
+    snapshot.Field( pointValue );
+
+  }
+
 };
 
 #endif //COST_H
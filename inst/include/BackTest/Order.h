@@ -20,6 +20,7 @@
 
 #include <Rcpp.h>
 #include "Tick.h"
+#include "../Snapshot.h"
 #include <vector>
 
 enum class ExecutionType: int { TRADE, BBO };
@@ -48,6 +49,7 @@ class Order {
 
   friend class Processor;
   friend class Statistics;
+  friend class ProcessorMulti;
   friend class Test;
 
   private:
@@ -90,6 +92,38 @@ class Order {
     double bid;
     double ask;
 
+    bool isPooled = false; // allocated by Processor::NewOrder or adopted by Processor::Fork, released by processor
+    bool isParked = false; // waiting for price in Processor trigger book
+
+    std::size_t seq = 0; // processing order, set when sent
+    std::vector< Order* >* wakeups = nullptr; // parked orders cancelled by user are reported here
+    std::function< void() >* onTouch = nullptr; // processor hook called before parked order is cancelled, see ProcessorMulti
+
+    // true if Update cannot change registered limit or not activated stop order on this tick
+    // bid and ask are the ones order would have seen, see end of Update
+    bool IsQuiet( const Tick& tick, double bid, double ask ) {
+
+      if( state != OrderState::REGISTERED or stateExchange != OrderStateExchange::REGISTERED ) return false;
+
+      if( type == OrderType::LIMIT ) {
+
+        if( executionType == ExecutionType::TRADE ) return tick.system or ( side == OrderSide::BUY ? tick.price >= price : tick.price <= price );
+
+        return side == OrderSide::BUY ? ask > price : bid < price;
+
+      }
+      if( type == OrderType::STOP and not isStopActivated ) {
+
+        if( executionType == ExecutionType::TRADE ) return tick.system or ( side == OrderSide::BUY ? tick.price <= price : tick.price >= price );
+
+        return side == OrderSide::BUY ? ask < price : bid > price;
+
+      }
+
+      return false;
+
+    }
+
     void Update( Tick tick, double latencySend, double latencyReceive ) {
 
       if( state == OrderState::CANCELLED or state == OrderState::EXECUTED ) {
@@ -275,6 +309,45 @@ class Order {
 
     };
 
+    // callbacks are not saved, pool and processor pointers are set by processor
+    void Serialize( Snapshot& snapshot ) {
+
+      snapshot.Field( state                  );
+      snapshot.Field( stateExchange          );
+      snapshot.Field( side                   );
+      snapshot.Field( type                   );
+      snapshot.Field( price                  );
+      snapshot.Field( trail                  );
+      snapshot.Field( priceExecuted          );
+      snapshot.Field( idTrade                );
+      snapshot.Field( idSent                 );
+      snapshot.Field( idRegistered           );
+      snapshot.Field( idCancel               );
+      snapshot.Field( idProcessed            );
+      snapshot.Field( idExchangeRegistered   );
+      snapshot.Field( idExchangeExecuted     );
+      snapshot.Field( timeSent               );
+      snapshot.Field( timeExchangeRegistered );
+      snapshot.Field( timeRegistered         );
+      snapshot.Field( timeExchangeExecuted   );
+      snapshot.Field( timeExecuted           );
+      snapshot.Field( timeCancel             );
+      snapshot.Field( timeExchangeCancel     );
+      snapshot.Field( timeCancelled          );
+      snapshot.Field( timeProcessed          );
+      snapshot.Field( allowLimitToHitMarket  );
+      snapshot.Field( allowExactStop         );
+      snapshot.Field( isStopActivated        );
+      snapshot.Field( priceExchangeExecuted  );
+      snapshot.Field( executionType          );
+      snapshot.Field( bid                    );
+      snapshot.Field( ask                    );
+      snapshot.Field( isParked               );
+      snapshot.Field( seq                    );
+      snapshot.Field( comment                );
+
+    }
+
   public:
 
     std::string comment;
@@ -328,7 +401,9 @@ class Order {
     void Cancel() {
 
       if( type != OrderType::MARKET and state == OrderState::REGISTERED ) {
+        if( isParked and onTouch != nullptr and *onTouch != nullptr ) ( *onTouch )();
         state = OrderState::CANCELLING;
+        if( isParked and wakeups != nullptr ) wakeups->push_back( this );
       }
 
     };
@@ -23,20 +23,28 @@
 #include "Candle.h"
 #include "Cost.h"
 #include "Tick.h"
+#include "Ticks.h"
 #include "Statistics.h"
 #include "../CppToR.h"
 #include "../ListBuilder.h"
 #include "../NPeriods.h"
 #include "../Alarm.h"
 #include "../Utils.h"
+#include "../Pool.h"
+#include "../ColumnBuffer.h"
+#include "../Snapshot.h"
+#include "../SharedVector.h"
 #include <map>
+#include <memory>
 #include <cmath>
+#include <algorithm>
 #include <Rcpp.h>
 
 class Processor {
 
   friend class Test;
   friend class Statistics;
+  friend class ProcessorMulti;
 
 private:
 
@@ -46,13 +54,110 @@ private:
   std::vector< std::string > OrderStateString = { "new", "registered", "executed", "cancelling", "cancelled" };
   std::vector< std::string > TradeStateString = { "new", "opened", "closed", "closing" };
 
-  std::vector<Order*> orders;
-  std::vector<Order*> ordersProcessed;
+  // orders and trades allocated by processor
+  struct Memory {
 
-  std::map< int, Trade*> trades;
-  std::map< int, Trade*> tradesProcessed;
+    Pool<Order> orderPool;
+    Pool<Trade> tradePool;
+    std::vector<Order*> orders; // processed orders allocated with new and adopted on Fork
 
-  std::vector<Candle> candles;
+    ~Memory() { for( auto order: orders ) delete order; }
+
+  };
+
+  // memory allocated before Fork is shared by forked processors and released with the last of them
+  std::shared_ptr< Memory > memory = std::make_shared< Memory >();
+  std::vector< std::shared_ptr< Memory > > memoryShared;
+
+  std::vector<Order*> orders; // active orders sorted by seq
+  SharedVector<Order*> ordersProcessed;
+
+  // registered limit and stop orders waiting for price to reach them, see Park
+  std::multimap< double, Order* > ordersFalling; // buy limits and sell stops
+  std::multimap< double, Order* > ordersRising;  // sell limits and buy stops
+  std::vector<Order*> wakeups; // parked orders cancelled by user
+  std::vector<Order*> woken;
+  std::size_t nOrdersSent = 0;
+
+  // called before processor is changed by orders sent, cancelled or trading stopped, see ProcessorMulti
+  std::function< void() > onTouch;
+
+  void Touch() { if( onTouch != nullptr ) onTouch(); }
+
+  // open trades sorted by id, closed trades in order of closing
+  std::vector<Trade*> trades;
+  SharedVector<Trade*> tradesProcessed;
+
+  // trades by id, dense for small non negative ids and sparse for the rest
+  std::vector<Trade*>    tradesById;
+  std::map< int, Trade*> tradesByIdSparse;
+
+  SharedVector<Candle> candles;
+
+  std::map< const Order*, Order* > ordersForked; // live orders of parent processor and their copies, see Fork
+
+  // candles and on candle portfolio history written straight to R vectors, see RecordHistoryToR
+  struct HistoryToR {
+
+    ColumnBuffer< REALSXP > time;
+    ColumnBuffer< REALSXP > open;
+    ColumnBuffer< REALSXP > high;
+    ColumnBuffer< REALSXP > low;
+    ColumnBuffer< REALSXP > close;
+    ColumnBuffer< INTSXP  > volume;
+    ColumnBuffer< INTSXP  > id;
+    ColumnBuffer< REALSXP > marketValue;
+    ColumnBuffer< REALSXP > drawDown;
+
+    void Reserve( std::size_t n ) {
+
+      time       .Reserve( n );
+      open       .Reserve( n );
+      high       .Reserve( n );
+      low        .Reserve( n );
+      close      .Reserve( n );
+      volume     .Reserve( n );
+      id         .Reserve( n );
+      marketValue.Reserve( n );
+      drawDown   .Reserve( n );
+
+    }
+
+    void Clear() {
+
+      time       .Clear();
+      open       .Clear();
+      high       .Clear();
+      low        .Clear();
+      close      .Clear();
+      volume     .Clear();
+      id         .Clear();
+      marketValue.Clear();
+      drawDown   .Clear();
+
+    }
+
+    void Serialize( Snapshot& snapshot ) {
+
+      time       .Serialize( snapshot );
+      open       .Serialize( snapshot );
+      high       .Serialize( snapshot );
+      low        .Serialize( snapshot );
+      close      .Serialize( snapshot );
+      volume     .Serialize( snapshot );
+      id         .Serialize( snapshot );
+      marketValue.Serialize( snapshot );
+      drawDown   .Serialize( snapshot );
+
+    }
+
+  };
+
+  // allocated by RecordHistoryToR only so processors running outside R main thread never touch R memory
+  std::unique_ptr< HistoryToR > historyToR;
+
+  // processed orders and closed trades are released and candles are not kept, see RecordSummaryOnly
+  bool isSummaryOnly = false;
 
   double prevTickTime;
   double latencySend;
@@ -82,21 +187,417 @@ private:
 
   double close;
 
+  int  nTicksFed   = 0;
+  bool isFinalized = false;
+
   bool isInInterval = false;
   std::vector<double> intervalStarts;
   std::vector<double> intervalEnds;
   int intervalId = 0;
 
+  Trade* FindTrade( int idTrade ) {
+
+    if( idTrade >= 0 and idTrade < (int)tradesById.size() and tradesById[ idTrade ] != nullptr ) return tradesById[ idTrade ];
+    if( tradesByIdSparse.empty() ) return nullptr;
+
+    auto it = tradesByIdSparse.find( idTrade );
+    return it == tradesByIdSparse.end() ? nullptr : it->second;
+
+  }
+
+  void AddTrade( Trade* trade ) {
+
+    int idTrade = trade->idTrade;
+
+    // dense index may only grow in proportion to number of trades so huge ids do not blow memory
+    std::size_t maxDenseSize = 1024 + 4 * ( tradesProcessed.size() + trades.size() + 1 );
+
+    if( idTrade >= 0 and (std::size_t)idTrade < maxDenseSize ) {
+
+      if( (std::size_t)idTrade >= tradesById.size() ) tradesById.resize( std::max( (std::size_t)idTrade + 1, tradesById.size() * 2 ), nullptr );
+      tradesById[ idTrade ] = trade;
+
+    } else tradesByIdSparse[ idTrade ] = trade;
+
+    // ids usually come in increasing order so this is O(1)
+    trades.push_back( trade );
+    for( auto i = trades.size() - 1; i > 0 and trades[ i - 1 ]->idTrade > idTrade; i-- ) std::swap( trades[i], trades[ i - 1 ] );
+
+  }
+
+  void ReplaceTrade( Trade* trade, Trade* copy ) {
+
+    int idTrade = trade->idTrade;
+
+    if( idTrade >= 0 and idTrade < (int)tradesById.size() and tradesById[ idTrade ] == trade ) tradesById[ idTrade ] = copy;
+    else tradesByIdSparse[ idTrade ] = copy;
+
+  }
+
+  // index entry of closed trade released in summary only mode, never written
+  static Trade* ReleasedTrade() {
+
+    static Trade released;
+    return &released;
+
+  }
+
+  // pooled orders allocated before Fork are released with shared memory
+  void ReleaseOrder( Order* order ) {
+
+    if( order->isPooled ) { if( memory->orderPool.Owns( order ) ) memory->orderPool.Delete( order ); } else delete order;
+
+  }
+
+  // closed trade id stays indexed so later orders of the same trade do not open new one
+  void ReleaseTrade( Trade* trade ) {
+
+    ReplaceTrade( trade, ReleasedTrade() );
+    if( memory->tradePool.Owns( trade ) ) memory->tradePool.Delete( trade );
+
+  }
+
+  // closed trade shared with forked processors is copied before it is updated
+  Trade* Unshare( Trade* trade ) {
+
+    Trade* copy = memory->tradePool.New( *trade );
+    copy->isShared = false;
+
+    ReplaceTrade( trade, copy );
+    for( auto i = tradesProcessed.size(); i > 0; i-- ) if( tradesProcessed[ i - 1 ] == trade ) { tradesProcessed.Set( i - 1, copy ); break; }
+
+    return copy;
+
+  }
+
+  // order is parked when nothing but price can change its state
+  bool CanPark( Order* order ) {
+
+    if( order->state != OrderState::REGISTERED or order->stateExchange != OrderStateExchange::REGISTERED or std::isnan( order->price ) ) return false;
+
+    return order->type == OrderType::LIMIT or ( order->type == OrderType::STOP and not order->isStopActivated );
+
+  }
+
+  void Park( Order* order ) {
+
+    bool isFalling = ( order->side == OrderSide::BUY ) == ( order->type == OrderType::LIMIT );
+
+    ( isFalling ? ordersFalling : ordersRising ).insert( std::make_pair( order->price, order ) );
+    order->isParked = true;
+
+  }
+
+  void Unpark( Order* order ) {
+
+    bool isFalling = ( order->side == OrderSide::BUY ) == ( order->type == OrderType::LIMIT );
+    auto& book = isFalling ? ordersFalling : ordersRising;
+
+    auto range = book.equal_range( order->price );
+    for( auto it = range.first; it != range.second; it++ ) if( it->second == order ) { book.erase( it ); break; }
+
+    order->isParked = false;
+    woken.push_back( order );
+
+  }
+
+  // lowest and highest of last bid and ask, one sided quote is bounded by its side only, NAN if both are NAN
+  double QuoteLow () const { return std::isnan( bid ) ? ask : std::isnan( ask ) ? bid : std::min( bid, ask ); }
+  double QuoteHigh() const { return std::isnan( bid ) ? ask : std::isnan( ask ) ? bid : std::max( bid, ask ); }
+
+  // moves parked orders which may be triggered by tick to woken
+  // bounds are not strict for BBO so some woken orders may still be quiet, they are parked back after processing
+  void WakeTriggered( const Tick& tick ) {
+
+    double falling = NAN; // wake falling orders priced at or above
+    double rising  = NAN; // wake rising  orders priced at or below
+
+    if( executionType == ExecutionType::TRADE and not tick.system ) {
+
+      falling = tick.price;
+      rising  = tick.price;
+
+    }
+    if( executionType == ExecutionType::BBO ) {
+
+      falling = QuoteLow ();
+      rising  = QuoteHigh();
+
+    }
+
+    if( not ordersFalling.empty() and not std::isnan( falling ) ) {
+
+      auto from = ordersFalling.lower_bound( falling );
+      for( auto it = from; it != ordersFalling.end(); it++ ) { it->second->isParked = false; woken.push_back( it->second ); }
+      ordersFalling.erase( from, ordersFalling.end() );
+
+    }
+    if( not ordersRising.empty() and not std::isnan( rising ) ) {
+
+      auto to = ordersRising.upper_bound( rising );
+      for( auto it = ordersRising.begin(); it != to; it++ ) { it->second->isParked = false; woken.push_back( it->second ); }
+      ordersRising.erase( ordersRising.begin(), to );
+
+    }
+
+  }
+
+  void WakeCancelled() {
+
+    for( auto order: wakeups ) if( order->isParked ) Unpark( order );
+    wakeups.clear();
+
+  }
+
+  // merges woken orders into active orders by seq
+  // returns number of woken orders sent before order with given seq
+  std::size_t MergeWoken( std::size_t seq ) {
+
+    if( woken.empty() ) return 0;
+
+    auto bySeq = []( Order* x, Order* y ) { return x->seq < y->seq; };
+
+    std::sort( woken.begin(), woken.end(), bySeq );
+
+    std::size_t nBefore = 0;
+    while( nBefore < woken.size() and woken[ nBefore ]->seq < seq ) nBefore++;
+
+    std::size_t n = orders.size();
+    orders.insert( orders.end(), woken.begin(), woken.end() );
+    std::inplace_merge( orders.begin(), orders.begin() + n, orders.end(), bySeq );
+
+    woken.clear();
+
+    return nBefore;
+
+  }
+
+  // pointers are saved as positions in list of all saved objects, nullptr as -1
+  template< class T >
+  static void SerializePointers( Snapshot& snapshot, const std::vector< T* >& all, std::vector< T* >& pointers ) {
+
+    std::vector< std::int64_t > positions;
+
+    if( not snapshot.IsLoading() ) {
+
+      std::map< T*, std::int64_t > position;
+      for( std::size_t i = 0; i < all.size(); i++ ) position[ all[i] ] = i;
+      for( auto pointer: pointers ) positions.push_back( pointer == nullptr ? -1 : position.at( pointer ) );
+
+    }
+
+    snapshot.Field( positions );
+
+    if( not snapshot.IsLoading() ) return;
+
+    pointers.clear();
+    for( auto i: positions ) {
+
+      if( i >= (std::int64_t)all.size() ) throw std::invalid_argument( "snapshot is corrupted" );
+      pointers.push_back( i < 0 ? nullptr : all[i] );
+
+    }
+
+  }
+
+  // trading stopped for good with flat position and no live orders so ticks can change nothing but statistics
+  // only in summary only mode as callbacks, candles and history are skipped from now on
+  // once true it stays true until Reset as no order can be sent after trading is stopped
+  bool IsOver() {
+
+    if( not isSummaryOnly or not isTradingStopped or statistics.position != 0 ) return false;
+    if( not orders.empty() or not ordersFalling.empty() or not ordersRising.empty() or not wakeups.empty() ) return false;
+
+    // trades of cancelled orders stay new and do not change anything
+    for( auto trade: trades ) if( not trade->IsNew() ) return false;
+
+    return true;
+
+  }
+
+  // market value does not change after IsOver so statistics is fed first tick of every day and the last tick only
+  // returns number of the first tick not fed, stops at ticks which are not time ordered or would change market value
+  std::size_t FastForward( const Ticks& ticks, std::size_t from ) {
+
+    std::size_t n = ticks.size();
+    const double* times  = ticks.GetTime();
+    const double* prices = ticks.GetPrice();
+    const double* bids   = ticks.GetBid();
+    const double* asks   = ticks.GetAsk();
+    const bool*   system = ticks.GetSystem();
+
+    bool isBBO = executionType == ExecutionType::BBO;
+
+    // market value of flat position is not a number if ask is not, ticks are left to FeedOver until it is back
+    if( statistics.marketValue != statistics.totalPnl or ( isBBO and not std::isfinite( statistics.ask ) ) ) return from;
+
+    std::size_t to = from;
+    std::size_t iLast = n; // last tick which is not system
+
+    for( double time = prevTickTime; to < n; time = times[to++] ) {
+
+      if( times[to] < time ) break; // left to FeedOver to report
+
+      if( system != nullptr and system[to] ) continue;
+
+      // flat market value is not a number if price is not or if ask of the previous tick is not
+      if( not std::isfinite( isBBO ? asks[to] : prices[to] ) ) break;
+
+      iLast = to;
+
+    }
+
+    Tick tick;
+
+    for( std::size_t i = from; i < to; ) {
+
+      ticks.Get( i, tick );
+      tick.id = nTicksFed + i;
+
+      statistics.Update( tick );
+      prevTickTime = tick.time;
+
+      if( i == to - 1 ) break;
+
+      // ticks are time ordered so next day starts at the first tick not earlier than midnight
+      double nextDay = ( (int)tick.time / nSecondsInDay + 1 ) * (double)nSecondsInDay;
+      i = std::min( (std::size_t)( std::lower_bound( times + i + 1, times + to, nextDay ) - times ), to - 1 );
+
+    }
+
+    if( to == from ) return from;
+
+    if( isBBO and iLast != n ) {
+
+      bid = bids[ iLast ];
+      ask = asks[ iLast ];
+      statistics.bid = bid;
+      statistics.ask = ask;
+
+    }
+
+    isFinalized = false;
+
+    return to;
+
+  }
+
+  // feeds statistics only with tick FastForward stopped at
+  void FeedOver( const Tick& tick ) {
+
+    if( tick.time < prevTickTime ) { throw std::invalid_argument( "ticks must be time ordered tick.id = " + std::to_string( tick.id + 1 ) ); }
+
+    statistics.Update( tick );
+    prevTickTime = tick.time;
+
+    if( executionType == ExecutionType::BBO and not tick.system ) {
+
+      bid = tick.bid;
+      ask = tick.ask;
+
+    }
+
+    isFinalized = false;
+
+  }
+
+  // flat with nothing live and no tick callback so ticks can change nothing but current candle until GetNextClockTime
+  bool IsIdle() {
+
+    if( onTick != nullptr or statistics.position != 0 or statistics.marketValue != statistics.totalPnl ) return false;
+    if( not orders.empty() or not ordersFalling.empty() or not ordersRising.empty() or not wakeups.empty() or not woken.empty() ) return false;
+
+    // market value of flat position is not a number if ask is not
+    if( executionType == ExecutionType::BBO and not std::isfinite( statistics.ask ) ) return false;
+
+    // open trades track mark to market on every tick
+    for( auto trade: trades ) if( not trade->IsNew() ) return false;
+
+    return true;
+
+  }
+
+  // adds ticks from given one to current candle while processor is idle
+  // returns number of the first tick not fed, stops at ticks which would change market value
+  std::size_t FeedIdle( const Ticks& ticks, std::size_t from ) {
+
+    double until = GetNextClockTime();
+
+    std::size_t n = ticks.size();
+    const double* times   = ticks.GetTime();
+    const double* prices  = ticks.GetPrice();
+    const int*    volumes = ticks.GetVolume();
+    const double* bids    = ticks.GetBid();
+    const double* asks    = ticks.GetAsk();
+    const bool*   system  = ticks.GetSystem();
+
+    bool isBBO = executionType == ExecutionType::BBO;
+
+    std::size_t i = from;
+    std::size_t iLast = n; // last tick which is not system
+
+    for( ; i < n and times[i] < until; i++ ) {
+
+      if( times[i] < prevTickTime ) break; // left to Feed to report
+
+      if( system != nullptr and system[i] ) { prevTickTime = times[i]; continue; }
+
+      if( not std::isfinite( prices[i] ) or ( isBBO and not std::isfinite( asks[i] ) ) ) break;
+
+      candle.Add( prices[i], volumes[i] );
+      prevTickTime = times[i];
+      iLast = i;
+
+    }
+
+    if( i == from ) return from;
+
+    candle.id = nTicksFed + i - 1;
+
+    statistics.prevTickTime = prevTickTime;
+    statistics.testEnd      = prevTickTime;
+
+    if( isBBO and iLast != n ) {
+
+      bid = bids[ iLast ];
+      ask = asks[ iLast ];
+      statistics.bid = bid;
+      statistics.ask = ask;
+
+    }
+
+    isFinalized = false;
+
+    return i;
+
+  }
+
+  void AddCandleToR( const Candle& candle ) {
+
+    bool isMarketValueNA = std::isnan( statistics.marketValue );
+
+    historyToR->time       .Add( candle.time   );
+    historyToR->open       .Add( candle.open   );
+    historyToR->high       .Add( candle.high   );
+    historyToR->low        .Add( candle.low    );
+    historyToR->close      .Add( candle.close  );
+    historyToR->volume     .Add( candle.volume );
+    historyToR->id         .Add( candle.id + 1 );
+    historyToR->marketValue.Add( isMarketValueNA ? 0 : statistics.marketValue );
+    historyToR->drawDown   .Add( isMarketValueNA ? 0 : statistics.drawDown    );
+
+  }
+
   void FormCandle( const Tick& tick ) {
 
     if( candle.IsFormed( tick ) ) {
 
       if( onCandle != nullptr ) onCandle( candle );
 
-      candles.push_back( candle );
+      if( historyToR != nullptr ) AddCandleToR( candle ); else if( not isSummaryOnly ) candles.push_back( candle );
       if( not std::isnan( candle.close ) ) close = candle.close;
 
-      statistics.Update( candle );
+      if( historyToR == nullptr ) statistics.Update( candle );
 
     }
 
@@ -341,21 +842,39 @@ public:
 
     if( onTick != nullptr and not tick.system ) onTick( tick );
 
-    // allocate memory to prevent iterators invalidation in case some orders have callbacks which send new orders
-    auto reserve = orders.size() < 10 ? 20 : orders.size() * 2;
-    orders.reserve( reserve );
+    // only parked orders reached by price or cancelled are processed
+    WakeCancelled();
+    WakeTriggered( tick );
+    MergeWoken( 0 );
 
-    for( auto it = orders.begin(); it != orders.end();  ) {
+    // orders sent by callbacks are appended and processed on the same tick
+    // finished orders stay in place until all orders are processed
+    for( std::size_t i = 0; i < orders.size(); i++ ) {
 
-      Order* order = (*it);
+      Order* order = orders[i];
+
+      // resting limit orders not reached by price are left untouched
+      if( order->IsQuiet( tick, bid, ask ) ) continue;
+
+      // order bid and ask are not updated while order is quiet
+      if( executionType == ExecutionType::BBO ) {
+
+        order->bid = bid;
+        order->ask = ask;
+
+      }
 
       order->Update( tick, latencySend, latencyReceive );
 
       statistics.Update( order );
 
-      if( trades.count( order->idTrade ) == 0 and tradesProcessed.count( order->idTrade ) == 0 ) {
+      Trade* trade = FindTrade( order->idTrade );
+
+      if( trade != nullptr and trade->isShared ) trade = Unshare( trade );
+
+      if( trade == nullptr ) {
 
-        Trade* trade    = new Trade;
+        trade           = memory->tradePool.New();
 
         trade->idTrade  = order->idTrade;
         trade->state    = TradeState::NEW;
@@ -363,11 +882,9 @@ public:
         trade->timeSent = order->timeSent;
         trade->cost     = cost.order;
 
-        trades[ order->idTrade ] = trade;
+        AddTrade( trade );
 
-      } else {
-
-        Trade* trade = tradesProcessed.count( order->idTrade ) != 0 ? tradesProcessed[ order->idTrade ] : trades[ order->idTrade ];
+      } else if( trade != ReleasedTrade() ) {
 
         if( order->IsExecuted() ) {
 
@@ -406,18 +923,33 @@ public:
 
       }
 
-      if( order->IsExecuted() or order->IsCancelled() ) {
+      // parked orders cancelled by callbacks are processed on this tick if sent after current order
+      if( not wakeups.empty() ) {
 
-        ordersProcessed.push_back( order );
-        it = orders.erase( it );
+        WakeCancelled();
+        i += MergeWoken( order->seq );
 
-      } else ++it;
+      }
 
     }
 
-    for( auto it = trades.begin(); it != trades.end();  ) {
+    std::size_t nOrders = 0;
+
+    for( auto order: orders ) {
+
+      if( order->IsExecuted() or order->IsCancelled() ) { if( isSummaryOnly ) ReleaseOrder( order ); else ordersProcessed.push_back( order ); }
+      else if( CanPark( order ) ) Park( order );
+      else orders[ nOrders++ ] = order;
+
+    }
 
-      Trade* trade = it->second;
+    orders.resize( nOrders );
+
+    std::size_t nTrades = 0;
+
+    for( std::size_t i = 0; i < trades.size(); i++ ) {
+
+      Trade* trade = trades[i];
 
       if( trade->IsOpened() ) {
 
@@ -427,6 +959,7 @@ public:
 
           trade->cost += nNights * ( trade->IsLong() ? cost.longAbs : cost.shortAbs );
           trade->cost += nNights * ( trade->IsLong() ? cost.longRel : cost.shortRel ) * close * cost.pointValue;
+          trade->costRel = trade->cost / ( trade->priceEnter * cost.pointValue );
 
         }
 
@@ -458,7 +991,11 @@ public:
 
         if( isTradingStopped and not trade->IsClosing() ) {
 
-          Order* order = new Order( trade->IsLong() ? OrderSide::SELL : OrderSide::BUY, OrderType::MARKET, NA_REAL, "stop", trade->idTrade );
+          Order* order = NewOrder( trade->IsLong() ? OrderSide::SELL : OrderSide::BUY, OrderType::MARKET, NA_REAL, "stop", trade->idTrade );
+
+          order->seq     = nOrdersSent++;
+          order->wakeups = &wakeups;
+          order->onTouch = &onTouch;
 
           orders.push_back( order );
           statistics.Update( order );
@@ -469,18 +1006,16 @@ public:
 
       }
 
-      if( trade->IsClosed() ) {
-
-        tradesProcessed[it->first] = trade;
-        it = trades.erase( it );
-
-      } else ++it;
+      if( trade->IsClosed() ) { if( isSummaryOnly ) ReleaseTrade( trade ); else tradesProcessed.push_back( trade ); } else trades[ nTrades++ ] = trade;
 
     }
 
+    trades.resize( nTrades );
+
     statistics.Update( tick );
 
     prevTickTime = tick.time;
+    isFinalized  = false;
 
     if( executionType == ExecutionType::BBO and not tick.system ) {
 
@@ -494,80 +1029,148 @@ public:
   Statistics GetStatistics() { return statistics; }
   Candle GetCandle() const { return candle; }
 
+  // system ticks before returned time change nothing but last tick time and id
+  // -INFINITY if next tick must be fed whatever it is
+  double GetNextClockTime() {
+
+    if( candle.time == 0 or not orders.empty() or not wakeups.empty() ) return -INFINITY;
+
+    if( not isTradingStopped and ( statistics.drawDown < stopTradingDrawdown or statistics.marketValue < stopTradingLoss ) ) return -INFINITY;
+    if( isTradingStopped and not trades.empty() ) return -INFINITY;
+
+    // parked orders are woken by last bid and ask on system ticks too
+    if( executionType == ExecutionType::BBO ) {
+
+      double falling = QuoteLow ();
+      double rising  = QuoteHigh();
+
+      if( not ordersFalling.empty() and not std::isnan( falling ) and ordersFalling.lower_bound( falling ) != ordersFalling.end() ) return -INFINITY;
+      if( not ordersRising .empty() and not std::isnan( rising  ) and ordersRising.begin()->first <= rising ) return -INFINITY;
+
+    }
+
+    double time = std::min( candle.time, ( (int)prevTickTime / nSecondsInDay + 1 ) * (double)nSecondsInDay );
+
+    if( onMarketOpen  != nullptr ) time = std::min( time, alarmMarketOpen .GetNextRingTime() );
+    if( onMarketClose != nullptr ) time = std::min( time, alarmMarketClose.GetNextRingTime() );
+
+    if( (std::size_t)intervalId < intervalStarts.size() ) time = std::min( time, isInInterval ? intervalEnds[ intervalId ] : intervalStarts[ intervalId ] );
+
+    if( prevTickTime < startTradingTime ) time = std::min( time, startTradingTime );
+
+    // bounds above are inclusive or strict, margin covers rounding
+    return time - 1e-3;
+
+  }
+
   void StopTrading() {
 
+    if( not isTradingStopped ) Touch();
     isTradingStopped = true;
 
   }
 
   void Feed( Rcpp::DataFrame ticks ) {
 
+    Feed( Ticks( ticks ) );
 
-    Rcpp::StringVector names = ticks.attr( "names" );
+  }
+
+  // ticks are read only so the same Ticks can be fed to many processors at once
+  void Feed( const Ticks& ticks ) {
 
-    bool hasTime   = std::find( names.begin(), names.end(), "time"   ) != names.end();
-    bool hasPrice  = std::find( names.begin(), names.end(), "price"  ) != names.end();
-    bool hasVolume = std::find( names.begin(), names.end(), "volume" ) != names.end();
+    FeedChunk( ticks );
+    Finalize();
 
-    bool hasBid    = std::find( names.begin(), names.end(), "bid"    ) != names.end();
-    bool hasAsk    = std::find( names.begin(), names.end(), "ask"    ) != names.end();
-    bool hasSystem = std::find( names.begin(), names.end(), "system" ) != names.end();
+  }
 
-    if( !hasTime   ) throw std::invalid_argument( "ticks must contain 'time' column"   );
-    if( !hasPrice  ) throw std::invalid_argument( "ticks must contain 'price' column"  );
-    if( !hasVolume ) throw std::invalid_argument( "ticks must contain 'volume' column" );
+  void FeedChunk( Rcpp::DataFrame ticks ) {
+
+    FeedChunk( Ticks( ticks ) );
+
+  }
+
+  // continues from where previous chunk stopped, statistics are not finalized until Finalize is called
+  // tick ids are counted from the first tick of the first chunk
+  void FeedChunk( const Ticks& ticks ) {
 
     if( executionType == ExecutionType::BBO ) {
 
-      if( !hasBid ) throw std::invalid_argument( "ticks must contain 'bid' column"  );
-      if( !hasAsk ) throw std::invalid_argument( "ticks must contain 'ask' column" );
+      if( !ticks.HasBid() ) throw std::invalid_argument( "ticks must contain 'bid' column"  );
+      if( !ticks.HasAsk() ) throw std::invalid_argument( "ticks must contain 'ask' column" );
 
     }
 
-    Rcpp::NumericVector  bids;
-    Rcpp::NumericVector  asks;
-    Rcpp::LogicalVector  systems;
+    if( ticks.GetTimeZone().empty() ) throw std::invalid_argument( "ticks timezone must be set" );
 
-    Rcpp::NumericVector  times   = ticks[ "time"   ];
-    Rcpp::NumericVector  prices  = ticks[ "price"  ];
-    Rcpp::IntegerVector  volumes = ticks[ "volume" ];
-    if( hasBid    )      bids    = ticks[ "bid"    ];
-    if( hasAsk    )      asks    = ticks[ "ask"    ];
-    if( hasSystem )      systems = ticks[ "system" ];
+    timeZone = ticks.GetTimeZone();
 
-    std::vector<std::string> tzone = times.attr( "tzone" );
+    auto n = ticks.size();
 
-    if( tzone.empty() ) throw std::invalid_argument( "ticks timezone must be set" );
+    Tick tick;
 
-    timeZone = tzone[0];
+    for( std::size_t i = 0; i < n; i++ ) {
 
-    auto n = times.size();
+      // ticks left after trading is over only update statistics
+      if( IsOver() ) {
 
-    Tick tick;
+        i = FastForward( ticks, i );
+        if( i == n ) break;
 
-    for( auto id = 0; id < n; id++ ) {
+        ticks.Get( i, tick );
+        tick.id = nTicksFed + i;
 
-      tick.id     = id;
-      tick.time   = times  [id];
-      tick.price  = prices [id];
-      tick.volume = volumes[id];
-      if( hasBid    ) tick.bid    = bids   [id];
-      if( hasAsk    ) tick.ask    = asks   [id];
-      if( hasSystem ) tick.system = systems[id];
+        FeedOver( tick );
+        continue;
+
+      }
+
+      // quiet ticks only add up to current candle
+      if( IsIdle() ) {
+
+        i = FeedIdle( ticks, i );
+        if( i == n ) break;
+
+      }
+
+      ticks.Get( i, tick );
+      tick.id = nTicksFed + i;
 
       Feed( tick );
 
     }
 
+    nTicksFed += n;
+
+  }
+
+  // closes last day statistics, called once at the end of ticks stream
+  void Finalize() {
+
+    if( isFinalized ) return;
+
     statistics.Finalize();
+    isFinalized = true;
+
+  }
+
+  // order allocated from processor pool, cheaper than new Order for strategies sending many orders
+  template< class... Args >
+  Order* NewOrder( Args&&... args ) {
+
+    Order* order = memory->orderPool.New( std::forward< Args >( args )... );
+    order->isPooled = true;
+    return order;
 
   }
 
   void SendOrder( Order* order ) {
 
+    Touch();
+
     if( not CanTrade() ) {
 
-      delete order;
+      ReleaseOrder( order );
       return;
 
     }
@@ -598,12 +1201,35 @@ public:
 
     }
 
+    order->seq     = nOrdersSent++;
+    order->wakeups = &wakeups;
+    order->onTouch = &onTouch;
+
     orders.push_back( order );
     statistics.Update( order );
 
   }
 
-  void CancelOrders() { for( auto order: orders ) order->Cancel( ); }
+  void CancelOrders() {
+
+    for( auto order: orders        ) order->Cancel( );
+    for( auto r    : ordersFalling ) r.second->Cancel( );
+    for( auto r    : ordersRising  ) r.second->Cancel( );
+
+  }
+
+  // active and parked orders in order sent
+  std::vector<Order*> GetLiveOrders() {
+
+    std::vector<Order*> live = orders;
+    for( auto r: ordersFalling ) live.push_back( r.second );
+    for( auto r: ordersRising  ) live.push_back( r.second );
+
+    std::sort( live.begin(), live.end(), []( Order* x, Order* y ) { return x->seq < y->seq; } );
+
+    return live;
+
+  }
 
   bool CanTrade() { return not( prevTickTime < startTradingTime or isTradingStopped ); }
 
@@ -615,43 +1241,389 @@ public:
 
   void Reset() {
 
-    for( auto order: orders ) delete order;
+    for( auto order: orders          ) if( not order->isPooled ) delete order;
+    for( auto order: ordersProcessed ) if( not order->isPooled ) delete order;
+    for( auto r    : ordersFalling   ) if( not r.second->isPooled ) delete r.second;
+    for( auto r    : ordersRising    ) if( not r.second->isPooled ) delete r.second;
     orders.clear();
-
-    for( auto order: ordersProcessed ) delete order;
     ordersProcessed.clear();
+    ordersFalling.clear();
+    ordersRising.clear();
+    wakeups.clear();
+    woken.clear();
+    nOrdersSent = 0;
+
+    // pooled orders and trades are released at once
+    memory->orderPool.Clear();
+    memory->tradePool.Clear();
+    memoryShared.clear();
+    ordersForked.clear();
 
-    for( auto r: trades ) delete r.second;
     trades.clear();
-
-    for( auto r: tradesProcessed ) delete r.second;
     tradesProcessed.clear();
+    tradesById.clear();
+    tradesByIdSparse.clear();
 
     statistics.Reset();
+    if( historyToR != nullptr ) historyToR->Clear();
     prevTickTime = 0;
     isTradingStopped = false;
+    nTicksFed   = 0;
+    isFinalized = false;
+  }
+
+  // saves processor state to snapshot or restores it from snapshot
+  // orders, trades, candles, current candle, alarms, intervals, statistics and settings are saved
+  // callbacks of processor and orders are not saved and must be set again before ticks are fed
+  // must be called before Finalize so ticks can be fed after restore, use FeedChunk instead of Feed
+  void Serialize( Snapshot& snapshot ) {
+
+    if( not snapshot.IsLoading() and isFinalized ) throw std::invalid_argument( "snapshot must be saved before statistics are finalized, use FeedChunk" );
+
+    if( snapshot.IsLoading() ) Reset();
+
+    snapshot.Check( timeFrame );
+
+    // orders
+    std::uint64_t nOrdersProcessed = ordersProcessed.size();
+    std::uint64_t nOrders          = orders         .size();
+    std::uint64_t nOrdersFalling   = ordersFalling  .size();
+    std::uint64_t nOrdersRising    = ordersRising   .size();
+
+    snapshot.Field( nOrdersProcessed );
+    snapshot.Field( nOrders          );
+    snapshot.Field( nOrdersFalling   );
+    snapshot.Field( nOrdersRising    );
+
+    std::vector< Order* > ordersAll;
+
+    if( snapshot.IsLoading() ) {
+
+      for( std::uint64_t i = 0; i < nOrdersProcessed + nOrders + nOrdersFalling + nOrdersRising; i++ ) {
+
+        Order* order = NewOrder( OrderSide::BUY, OrderType::MARKET, NA_REAL, "" );
+        order->wakeups = &wakeups;
+        order->onTouch = &onTouch;
+        ordersAll.push_back( order );
+
+      }
+
+    } else {
+
+      ordersAll = ordersProcessed.Get();
+      ordersAll.insert( ordersAll.end(), orders.begin(), orders.end() );
+      for( auto r: ordersFalling ) ordersAll.push_back( r.second );
+      for( auto r: ordersRising  ) ordersAll.push_back( r.second );
+
+    }
+
+    for( auto order: ordersAll ) order->Serialize( snapshot );
+
+    if( snapshot.IsLoading() ) {
+
+      auto order = ordersAll.begin();
+
+      for( std::uint64_t i = 0; i < nOrdersProcessed; i++, order++ ) ordersProcessed.push_back( *order );
+      orders         .assign( order, order + nOrders          ); order += nOrders;
+      // equal prices keep their order as multimap inserts equal keys at the end
+      for( std::uint64_t i = 0; i < nOrdersFalling; i++, order++ ) ordersFalling.insert( std::make_pair( ( *order )->price, *order ) );
+      for( std::uint64_t i = 0; i < nOrdersRising ; i++, order++ ) ordersRising .insert( std::make_pair( ( *order )->price, *order ) );
+
+    }
+
+    SerializePointers( snapshot, ordersAll, wakeups );
+    SerializePointers( snapshot, ordersAll, woken   );
+    snapshot.Field( nOrdersSent );
+
+    // trades
+    snapshot.Field( isSummaryOnly );
+
+    std::uint64_t nTradesProcessed = tradesProcessed.size();
+    std::uint64_t nTrades          = trades         .size();
+
+    snapshot.Field( nTradesProcessed );
+    snapshot.Field( nTrades          );
+
+    std::vector< Trade* > tradesAll;
+
+    if( snapshot.IsLoading() ) {
+
+      for( std::uint64_t i = 0; i < nTradesProcessed + nTrades; i++ ) tradesAll.push_back( memory->tradePool.New() );
+
+    } else {
+
+      tradesAll = tradesProcessed.Get();
+      tradesAll.insert( tradesAll.end(), trades.begin(), trades.end() );
+
+    }
+
+    for( auto trade: tradesAll ) trade->Serialize( snapshot );
+
+    if( snapshot.IsLoading() ) {
+
+      for( std::uint64_t i = 0; i < nTradesProcessed; i++ ) tradesProcessed.push_back( tradesAll[i] );
+      trades         .assign( tradesAll.begin() + nTradesProcessed, tradesAll.end() );
+
+    }
+
+    // released trades are indexed after all saved ones
+    if( isSummaryOnly ) tradesAll.push_back( ReleasedTrade() );
+
+    std::vector< int    > idsSparse;
+    std::vector< Trade* > tradesSparse;
+    for( auto r: tradesByIdSparse ) { idsSparse.push_back( r.first ); tradesSparse.push_back( r.second ); }
+
+    SerializePointers( snapshot, tradesAll, tradesById );
+    snapshot.Field( idsSparse );
+    SerializePointers( snapshot, tradesAll, tradesSparse );
+
+    if( snapshot.IsLoading() ) {
+
+      if( idsSparse.size() != tradesSparse.size() ) throw std::invalid_argument( "snapshot is corrupted" );
+      for( std::size_t i = 0; i < idsSparse.size(); i++ ) tradesByIdSparse[ idsSparse[i] ] = tradesSparse[i];
+
+    }
+
+    // candles
+    bool isHistoryToR = historyToR != nullptr;
+    snapshot.Field( isHistoryToR );
+
+    if( snapshot.IsLoading() ) historyToR.reset( isHistoryToR ? new HistoryToR() : nullptr );
+
+    if( historyToR != nullptr ) historyToR->Serialize( snapshot ); else {
+
+      std::uint64_t nCandles = candles.size();
+      snapshot.Field( nCandles );
+
+      if( snapshot.IsLoading() ) {
+
+        for( std::uint64_t i = 0; i < nCandles; i++ ) {
+
+          Candle saved( timeFrame );
+          saved.Serialize( snapshot );
+          candles.push_back( saved );
+
+        }
+
+      } else for( auto saved: candles ) saved.Serialize( snapshot );
+
+    }
+
+    candle.Serialize( snapshot );
+
+    // settings and current state
+    snapshot.Field( prevTickTime   );
+    snapshot.Field( latencySend    );
+    snapshot.Field( latencyReceive );
+    cost.Serialize( snapshot );
+    snapshot.Field( timeZone );
+    alarmMarketOpen .Serialize( snapshot );
+    alarmMarketClose.Serialize( snapshot );
+
+    snapshot.Field( startTradingTime      );
+    snapshot.Field( stopTradingDrawdown   );
+    snapshot.Field( stopTradingLoss       );
+    snapshot.Field( isTradingStopped      );
+    snapshot.Field( allowLimitToHitMarket );
+    snapshot.Field( allowExactStop        );
+    snapshot.Field( priceStep             );
+    snapshot.Field( executionType         );
+
+    snapshot.Field( bid   );
+    snapshot.Field( ask   );
+    snapshot.Field( close );
+
+    snapshot.Field( nTicksFed );
+
+    snapshot.Field( isInInterval   );
+    snapshot.Field( intervalStarts );
+    snapshot.Field( intervalEnds   );
+    snapshot.Field( intervalId     );
+
+    statistics.Serialize( snapshot );
+
   }
 
-  std::vector<double> GetOnCandleMarketValueHistory() {  return statistics.onCandleHistoryMarketValue;  }
+  // processor state only, use Serialize to save indicators along with processor
+  Rcpp::RawVector GetSnapshot() {
 
-  std::vector<double> GetOnCandleDrawDownHistory() {  return statistics.onCandleHistoryDrawDown;  }
+    Snapshot snapshot;
+    Serialize( snapshot );
+    return snapshot.Get();
 
-  Rcpp::List GetOnDayClosePerformanceHistory() {
+  }
 
-    Rcpp::List performance = ListBuilder().AsDataTable()
-      .Add( "date"     , IntToDate( statistics.onDayCloseHistoryDates ) )
-      .Add( "return"   , statistics.onDayCloseHistoryMarketValueChange  )
-      .Add( "pnl"      , statistics.onDayCloseHistoryMarketValue        )
-      .Add( "drawdown" , statistics.onDayCloseHistoryDrawDown           )
-      .Add( "avg_pnl"  , statistics.onDayCloseHistoryAvgTradePnl        )
-      .Add( "n_per_day", statistics.onDayCloseHistoryNTrades            );
+  void SetSnapshot( Rcpp::RawVector data ) {
 
-    return performance;
+    Snapshot snapshot( data );
+    Serialize( snapshot );
 
   }
 
+  // new processor continuing test from current state, e.g. to run several scenarios after common warm up
+  // processed orders, closed trades, candles and statistics history are shared with fork and not copied
+  // live orders and open trades are copied, use GetForkedOrder to find copy of parent live order
+  // callbacks are not copied and must be set on fork before ticks are fed, fork must be deleted by caller
+  Processor* Fork() {
+
+    if( isFinalized  ) throw std::invalid_argument( "processor must be forked before statistics are finalized, use FeedChunk" );
+    if( historyToR != nullptr ) throw std::invalid_argument( "processor recording history to R can not be forked" );
+
+    Processor* fork = new Processor( timeFrame, latencySend, latencyReceive );
+
+    // objects allocated so far are shared from now on and both processors allocate from new pools
+    for( auto order: ordersProcessed ) if( not order->isPooled ) { memory->orders.push_back( order ); order->isPooled = true; }
+    for( auto trade: tradesProcessed ) if( not trade->isShared ) trade->isShared = true;
+
+    memoryShared.push_back( memory );
+    memory = std::make_shared< Memory >();
+    fork->memoryShared = memoryShared;
+
+    // live orders are copied through snapshot the same way they are restored, callbacks are not copied
+    auto copyOrder = [&]( Order* order ) {
+
+      Order* copy = fork->NewOrder( OrderSide::BUY, OrderType::MARKET, NA_REAL, "" );
+      copy->wakeups = &fork->wakeups;
+      copy->onTouch = &fork->onTouch;
+
+      Snapshot saved;
+      order->Serialize( saved );
+      Snapshot loaded = saved.Load();
+      copy->Serialize( loaded );
+
+      fork->ordersForked[ order ] = copy;
+      return copy;
+
+    };
+
+    fork->ordersProcessed = ordersProcessed;
+    for( auto order: orders        ) fork->orders.push_back( copyOrder( order ) );
+    for( auto r    : ordersFalling ) fork->ordersFalling.insert( fork->ordersFalling.end(), std::make_pair( r.first, copyOrder( r.second ) ) );
+    for( auto r    : ordersRising  ) fork->ordersRising .insert( fork->ordersRising .end(), std::make_pair( r.first, copyOrder( r.second ) ) );
+    for( auto order: wakeups       ) fork->wakeups.push_back( fork->ordersForked.at( order ) );
+    for( auto order: woken         ) fork->woken  .push_back( fork->ordersForked.at( order ) );
+    fork->nOrdersSent = nOrdersSent;
+
+    // trades
+    fork->tradesProcessed  = tradesProcessed;
+    fork->tradesById       = tradesById;
+    fork->tradesByIdSparse = tradesByIdSparse;
+
+    for( auto trade: trades ) {
+
+      Trade* copy = fork->memory->tradePool.New( *trade );
+      fork->trades.push_back( copy );
+      fork->ReplaceTrade( trade, copy );
+
+    }
+
+    // candles, settings and current state
+    fork->candles = candles;
+    fork->candle  = candle;
+
+    fork->prevTickTime     = prevTickTime;
+    fork->cost             = cost;
+    fork->timeZone         = timeZone;
+    fork->alarmMarketOpen  = alarmMarketOpen;
+    fork->alarmMarketClose = alarmMarketClose;
+
+    fork->startTradingTime      = startTradingTime;
+    fork->stopTradingDrawdown   = stopTradingDrawdown;
+    fork->stopTradingLoss       = stopTradingLoss;
+    fork->isTradingStopped      = isTradingStopped;
+    fork->allowLimitToHitMarket = allowLimitToHitMarket;
+    fork->allowExactStop        = allowExactStop;
+    fork->priceStep             = priceStep;
+    fork->executionType         = executionType;
+
+    fork->bid   = bid;
+    fork->ask   = ask;
+    fork->close = close;
+
+    fork->nTicksFed     = nTicksFed;
+    fork->isSummaryOnly = isSummaryOnly;
+
+    fork->isInInterval   = isInInterval;
+    fork->intervalStarts = intervalStarts;
+    fork->intervalEnds   = intervalEnds;
+    fork->intervalId     = intervalId;
+
+    fork->statistics = statistics;
+
+    return fork;
+
+  }
+
+  // copy of live order of parent processor when it was forked, nullptr if order was not live
+  Order* GetForkedOrder( const Order* order ) {
+
+    auto it = ordersForked.find( order );
+    return it == ordersForked.end() ? nullptr : it->second;
+
+  }
+
+  // records candles and on candle history directly to R vectors so GetCandles and GetOnCandle*History return them without conversion
+  // capacity for nCandles is reserved, must not be used when processor runs outside R main thread e.g. in Sweep
+  void RecordHistoryToR( std::size_t nCandles = 0 ) {
+
+    if( isSummaryOnly ) throw std::invalid_argument( "processor recording summary only can not record history to R" );
+
+    if( historyToR == nullptr ) historyToR.reset( new HistoryToR() );
+    historyToR->Reserve( nCandles );
+
+  }
+
+  // keeps only what GetSummary needs so memory does not grow with test length, e.g. for parameter sweeps
+  // processed orders are released after the tick they are executed or cancelled on so strategy must not access them afterwards
+  // candles, processed orders, closed trades and on candle and on day close histories are not kept
+  // once trading is stopped by loss or drawdown and position is closed remaining ticks only update statistics and no callbacks are called
+  void RecordSummaryOnly() {
+
+    if( historyToR != nullptr ) throw std::invalid_argument( "processor recording history to R can not record summary only" );
+
+    isSummaryOnly = true;
+    statistics.isSummaryOnly = true;
+
+  }
+
+  Rcpp::NumericVector GetOnCandleMarketValueHistory() {
+
+    if( historyToR != nullptr ) return historyToR->marketValue.Get();
+    return Rcpp::NumericVector( statistics.onCandleHistoryMarketValue.begin(), statistics.onCandleHistoryMarketValue.end() );
+
+  }
+
+  Rcpp::NumericVector GetOnCandleDrawDownHistory() {
+
+    if( historyToR != nullptr ) return historyToR->drawDown.Get();
+    return Rcpp::NumericVector( statistics.onCandleHistoryDrawDown.begin(), statistics.onCandleHistoryDrawDown.end() );
+
+  }
+
+  Rcpp::List GetOnDayClosePerformanceHistory() { return statistics.GetOnDayClosePerformanceHistory(); }
+
   Rcpp::List GetCandles() {
 
+    if( historyToR != nullptr ) {
+
+      Rcpp::NumericVector time = historyToR->time.Get();
+      time.attr( "class" ) = Rcpp::CharacterVector::create( "POSIXct", "POSIXt" );
+      time.attr( "tzone" ) = Rcpp::CharacterVector::create( timeZone );
+
+      Rcpp::List candles = ListBuilder().AsDataTable()
+
+        .Add( "time"  , time                     )
+        .Add( "open"  , historyToR->open  .Get() )
+        .Add( "high"  , historyToR->high  .Get() )
+        .Add( "low"   , historyToR->low   .Get() )
+        .Add( "close" , historyToR->close .Get() )
+        .Add( "volume", historyToR->volume.Get() )
+        .Add( "id"    , historyToR->id    .Get() );
+
+      return candles;
+
+    }
+
     int n = candles.size();
 
     Rcpp::IntegerVector id    ( n );
@@ -663,7 +1635,7 @@ public:
     Rcpp::IntegerVector volume( n );
 
     int i = 0;
-    auto convertCandle = [&]( std::vector<Candle>::iterator it ) {
+    auto convertCandle = [&]( SharedVector<Candle>::const_iterator it ) {
 
       id    [i] = it->id + 1;
       open  [i] = it->open;
@@ -695,7 +1667,9 @@ public:
 
   Rcpp::List GetOrders() {
 
-    int n = orders.size() + ordersProcessed.size();
+    std::vector<Order*> ordersLive = GetLiveOrders();
+
+    int n = ordersLive.size() + ordersProcessed.size();
 
     Rcpp::IntegerVector   id_trade      ( n );
     Rcpp::IntegerVector   id_sent       ( n );
@@ -729,7 +1703,7 @@ public:
     };
 
     for( auto it = ordersProcessed.begin(); it != ordersProcessed.end(); it++ ) convertOrder( *it );
-    for( auto it = orders         .begin(); it != orders         .end(); it++ ) convertOrder( *it );
+    for( auto it = ordersLive     .begin(); it != ordersLive     .end(); it++ ) convertOrder( *it );
 
     Rcpp::List orders = ListBuilder().AsDataTable()
 
@@ -806,8 +1780,11 @@ public:
 
     };
 
-    for( auto it = tradesProcessed.begin(); it != tradesProcessed.end(); it++ ) convertTrade( it->second );
-    for( auto it = trades         .begin(); it != trades         .end(); it++ ) convertTrade( it->second );
+    std::vector<Trade*> tradesProcessedById = tradesProcessed.Get();
+    std::sort( tradesProcessedById.begin(), tradesProcessedById.end(), []( Trade* x, Trade* y ) { return x->idTrade < y->idTrade; } );
+
+    for( auto it = tradesProcessedById.begin(); it != tradesProcessedById.end(); it++ ) convertTrade( *it );
+    for( auto it = trades             .begin(); it != trades             .end(); it++ ) convertTrade( *it );
 
     Rcpp::List trades = ListBuilder().AsDataTable()
 
@@ -19,18 +19,300 @@
 #define PROCESSORMULTI_H
 
 #include "Processor.h"
-
+#include "../Parallel.h"
+#include <queue>
+#include <set>
+#include <tuple>
+
+// runs one processor per symbol on common tick stream
+// tick is fed to its symbol processor only, other processors get system tick only when their clock needs it
+// e.g. candle close, day start, market open / close, interval open / close or when they have live orders
+// results are the same as if every processor was fed every tick
+// portfolio statistics combine all processors as if every symbol was traded on its own capital unit
 class ProcessorMulti {
 
 private:
 
   std::vector< Processor* > processors;
   int n;
+  int nTicksFed = 0;
+  int nThreads  = 1;
+
+  std::vector< int > idLastFed; // id of last tick fed to processor
+
+  bool isFinalized = false;
+
+  // portfolio market value is sum of processors market values, trades of all processors are counted
+  Statistics portfolio;
+  Candle     portfolioCandle;
+  std::vector< double > portfolioCandleTimes;
+
+  // processors changes during chunk by tick number, merged into portfolio in tick order after chunk is processed
+  std::vector< double >      marketValues;
+  std::vector< std::size_t > nTradesCollected;
+  std::vector< std::size_t > nOrdersCollected;
+  std::vector< std::vector< std::pair< std::size_t, double > > > marketValueChanges;
+  std::vector< std::vector< std::pair< std::size_t, Trade* > > > tradesClosed;
+  std::vector< std::vector< std::pair< std::size_t, double > > > ordersExecuted;
+
+  // remembers portfolio changes made by processor p on i-th tick of chunk
+  void Collect( int p, std::size_t i ) {
+
+    Processor* processor = processors[p];
+
+    double marketValue = processor->statistics.marketValue;
+    if( std::isnan( marketValue ) ) marketValue = 0;
+
+    if( marketValue != marketValues[p] ) {
+
+      marketValueChanges[p].emplace_back( i, marketValue - marketValues[p] );
+      marketValues[p] = marketValue;
+
+    }
+
+    auto& trades = processor->tradesProcessed;
+    for( ; nTradesCollected[p] < trades.size(); nTradesCollected[p]++ ) tradesClosed[p].emplace_back( i, trades[ nTradesCollected[p] ] );
+
+    auto& orders = processor->ordersProcessed;
+    for( ; nOrdersCollected[p] < orders.size(); nOrdersCollected[p]++ ) {
+
+      Order* order = orders[ nOrdersCollected[p] ];
+      if( order->IsExecuted() ) ordersExecuted[p].emplace_back( i, order->timeExecuted );
+
+    }
+
+  }
+
+  // updates portfolio tick by tick in the same order processor updates its statistics
+  void MergePortfolio( const Ticks& ticks ) {
+
+    std::size_t nTicks = ticks.size();
+    const double* times = ticks.GetTime();
+
+    std::vector< double > change( nTicks, 0 );
+    std::vector< std::pair< std::size_t, Trade* > > trades;
+    std::vector< std::pair< std::size_t, double > > executions;
+
+    for( int p = 0; p < n; p++ ) {
+
+      for( auto& c: marketValueChanges[p] ) change[ c.first ] += c.second;
+      trades    .insert( trades    .end(), tradesClosed  [p].begin(), tradesClosed  [p].end() );
+      executions.insert( executions.end(), ordersExecuted[p].begin(), ordersExecuted[p].end() );
+
+      marketValueChanges[p].clear();
+      tradesClosed      [p].clear();
+      ordersExecuted    [p].clear();
+
+    }
+
+    // processors order is kept within tick
+    auto byTick = []( const std::pair< std::size_t, double >& x, const std::pair< std::size_t, double >& y ) { return x.first < y.first; };
+    auto byTickTrade = []( const std::pair< std::size_t, Trade* >& x, const std::pair< std::size_t, Trade* >& y ) { return x.first < y.first; };
+    std::stable_sort( trades    .begin(), trades    .end(), byTickTrade );
+    std::stable_sort( executions.begin(), executions.end(), byTick      );
+
+    auto trade     = trades    .begin();
+    auto execution = executions.begin();
+
+    double marketValue = portfolio.marketValue;
+
+    Tick tick;
+    tick.system = true;
+
+    for( std::size_t i = 0; i < nTicks; i++ ) {
+
+      tick.id   = nTicksFed + i;
+      tick.time = times[i];
+
+      if( portfolioCandle.IsFormed( tick ) ) {
+
+        portfolio.Update( portfolioCandle );
+        portfolioCandleTimes.push_back( portfolioCandle.time );
+
+      }
+      portfolioCandle.Add( tick );
+
+      for( ; execution != executions.end() and execution->first == i; execution++ ) portfolio.Update( execution->second );
+      for( ; trade     != trades    .end() and trade    ->first == i; trade    ++ ) portfolio.Update( trade->second );
+
+      marketValue += change[i];
+      portfolio.Update( times[i], marketValue );
+
+    }
+
+  }
+
+  // feeds i-th tick to processor p
+  // previous tick is fed first if processor missed it so last tick time and id are the same as if it was fed every tick
+  void FeedTick( int p, const Ticks& ticks, const std::vector< int >& symbols, std::size_t i ) {
+
+    if( i > 0 and idLastFed[p] < nTicksFed + (int)i - 1 ) FeedOne( p, ticks, symbols, i - 1 );
+
+    FeedOne( p, ticks, symbols, i );
+
+  }
+
+  void FeedOne( int p, const Ticks& ticks, const std::vector< int >& symbols, std::size_t i ) {
+
+    int id = nTicksFed + i;
+
+    Tick tick;
+
+    if( symbols[i] == p ) {
+
+      ticks.Get( i, tick );
+      tick.system = false;
+
+    } else {
+
+      tick.time   = ticks.GetTime()[i];
+      tick.price  = NAN;
+      tick.volume = 0;
+      tick.system = true;
+
+    }
+
+    tick.id = id;
+
+    processors[p]->Feed( tick );
+    idLastFed[p] = id;
+
+    Collect( p, i );
+
+  }
+
+  // ticks are processed one by one in time order, callbacks may access other processors
+  void FeedSequential( const Ticks& ticks, const std::vector< int >& symbols ) {
+
+    std::size_t nTicks = ticks.size();
+    const double* times = ticks.GetTime();
+
+    // processors waiting for clock time, entries of rescheduled processors are skipped by version
+    typedef std::tuple< double, int, int > Wait;
+    std::priority_queue< Wait, std::vector< Wait >, std::greater< Wait > > waiting;
+    std::vector< int > version( n, 0 );
+    std::vector< int > busy;
+    std::vector< int > touched;
+    std::set< int > due;
+
+    std::size_t i = 0;
+    int current = -1;
+
+    auto schedule = [&]( int p ) {
+
+      double time = processors[p]->GetNextClockTime();
+      version[p]++;
+
+      if( time == -INFINITY ) busy.push_back( p ); else if( time < INFINITY ) waiting.emplace( time, p, version[p] );
+
+    };
+
+    // processor changed by callbacks of current one is brought to the state it would have if it was fed every tick
+    // it is fed this tick if not fed yet or next tick otherwise
+    auto touch = [&]( int p ) {
+
+      if( current == -1 or p == current ) return;
+
+      int id = nTicksFed + i;
+
+      if( p < current and idLastFed[p] < id ) FeedTick( p, ticks, symbols, i );
+      if( p > current and idLastFed[p] < id - 1 and i > 0 ) FeedTick( p, ticks, symbols, i - 1 );
+
+      touched.push_back( p );
+
+    };
+
+    for( int p = 0; p < n; p++ ) processors[p]->onTouch = [&touch, p]() { touch( p ); };
+    for( int p = 0; p < n; p++ ) schedule( p );
+
+    // orders keep pointer to processor hook so it must not capture anything after this call
+    auto release = [&]() { for( int p = 0; p < n; p++ ) processors[p]->onTouch = nullptr; };
+
+    try {
+
+      for( ; i < nTicks; i++ ) {
+
+        int id = nTicksFed + i;
+
+        if( symbols[i] >= 0 and symbols[i] < n ) due.insert( symbols[i] );
+
+        due.insert( busy.begin(), busy.end() );
+        busy.clear();
+
+        while( not waiting.empty() and std::get<0>( waiting.top() ) <= times[i] ) {
+
+          int p = std::get<1>( waiting.top() );
+          if( std::get<2>( waiting.top() ) == version[p] ) due.insert( p );
+          waiting.pop();
+
+        }
+
+        // processors are fed in the same order as if every processor was fed every tick
+        while( not due.empty() ) {
+
+          current = *due.begin();
+          due.erase( due.begin() );
+
+          FeedTick( current, ticks, symbols, i );
+          schedule( current );
+
+          for( auto p: touched ) if( p > current and idLastFed[p] < id ) due.insert( p ); else schedule( p );
+          touched.clear();
+
+        }
+
+        current = -1;
+
+      }
+
+    } catch( ... ) {
+
+      release();
+      throw;
+
+    }
+
+    release();
+
+  }
+
+  // each processor is run through ticks on its own thread, callbacks must only access own processor and not call R API
+  void FeedParallel( const Ticks& ticks, const std::vector< int >& symbols ) {
+
+    std::size_t nTicks = ticks.size();
+    const double* times = ticks.GetTime();
+
+    std::vector< std::vector< std::size_t > > ownTicks( n );
+    for( std::size_t i = 0; i < nTicks; i++ ) if( symbols[i] >= 0 and symbols[i] < n ) ownTicks[ symbols[i] ].push_back( i );
+
+    ParallelFor( n, nThreads, [&]( std::size_t p ) {
+
+      auto own = ownTicks[p].begin();
+      std::size_t i = 0;
+
+      while( true ) {
+
+        std::size_t next = std::lower_bound( times + i, times + nTicks, processors[p]->GetNextClockTime() ) - times;
+        if( own != ownTicks[p].end() and *own < next ) next = *own;
+
+        if( next >= nTicks ) break;
+
+        FeedTick( p, ticks, symbols, next );
+
+        if( own != ownTicks[p].end() and *own == next ) own++;
+        i = next + 1;
+
+      }
+
+    } );
+
+  }
 
 public:
 
   ProcessorMulti( int timeFrame, int n ) :
-  n( n )
+  n( n ),
+  portfolioCandle( timeFrame )
   {
 
     for( auto i = 0; i < n; i++ ) {
@@ -39,6 +321,15 @@ public:
 
     }
 
+    idLastFed.resize( n, -1 );
+
+    marketValues      .resize( n, 0 );
+    nTradesCollected  .resize( n, 0 );
+    nOrdersCollected  .resize( n, 0 );
+    marketValueChanges.resize( n );
+    tradesClosed      .resize( n );
+    ordersExecuted    .resize( n );
+
   };
 
   ~ProcessorMulti() {
@@ -50,81 +341,87 @@ public:
 
   Processor* Get( int i ) { return processors[i]; }
 
+  // number of threads symbols are processed on ( 0 = all cores ), default is 1
+  // if more than 1 then callbacks must only access own processor and must not call R API, processors must not record history to R
+  void SetThreads( int nThreads ) { this->nThreads = nThreads; }
+
   void Feed( Rcpp::DataFrame ticks ) {
 
-    Rcpp::StringVector names = ticks.attr( "names" );
+    FeedChunk( ticks );
+    Finalize();
+
+  }
 
-    bool hasTime   = std::find( names.begin(), names.end(), "time"   ) != names.end();
-    bool hasPrice  = std::find( names.begin(), names.end(), "price"  ) != names.end();
-    bool hasVolume = std::find( names.begin(), names.end(), "volume" ) != names.end();
+  // continues from where previous chunk stopped, see Processor::FeedChunk
+  void FeedChunk( Rcpp::DataFrame ticks ) {
+
+    Rcpp::StringVector names = ticks.attr( "names" );
 
-    bool hasBid    = std::find( names.begin(), names.end(), "bid"    ) != names.end();
-    bool hasAsk    = std::find( names.begin(), names.end(), "ask"    ) != names.end();
-    //bool hasSystem = std::find( names.begin(), names.end(), "system" ) != names.end();
     bool hasSymbol = std::find( names.begin(), names.end(), "symbol" ) != names.end();
 
-    if( !hasTime   ) throw std::invalid_argument( "ticks must contain 'time' column"   );
-    if( !hasPrice  ) throw std::invalid_argument( "ticks must contain 'price' column"  );
-    if( !hasVolume ) throw std::invalid_argument( "ticks must contain 'volume' column" );
     if( !hasSymbol ) throw std::invalid_argument( "ticks must contain 'symbol' column" );
 
-  /*  if( executionType == ExecutionType::BBO ) {
+    Rcpp::IntegerVector symbols = ticks[ "symbol" ];
 
-      if( !hasBid ) throw std::invalid_argument( "ticks must contain 'bid' column"  );
-      if( !hasAsk ) throw std::invalid_argument( "ticks must contain 'ask' column" );
+    FeedChunk( Ticks( ticks ), std::vector< int >( symbols.begin(), symbols.end() ) );
 
-  }*/
+  }
 
-    Rcpp::NumericVector  bids;
-    Rcpp::NumericVector  asks;
-    Rcpp::LogicalVector  systems;
+  // symbols are processor indices, ticks of other symbols are fed as system ticks
+  void FeedChunk( const Ticks& ticks, const std::vector< int >& symbols ) {
 
-    Rcpp::NumericVector  times   = ticks[ "time"   ];
-    Rcpp::NumericVector  prices  = ticks[ "price"  ];
-    Rcpp::IntegerVector  volumes = ticks[ "volume" ];
+    std::size_t nTicks = ticks.size();
 
-    Rcpp::IntegerVector  symbols = ticks[ "symbol" ];
+    if( symbols.size() != nTicks ) throw std::invalid_argument( "symbols and ticks must be of the same length" );
+    if( nTicks == 0 ) return;
 
-    if( hasBid    )      bids    = ticks[ "bid"    ];
-    if( hasAsk    )      asks    = ticks[ "ask"    ];
-/*
-    std::vector<std::string> tzone = times.attr( "tzone" );
+    // portfolio is merged from processed orders and closed trades
+    for( auto processor: processors ) if( processor->isSummaryOnly ) throw std::invalid_argument( "processors of ProcessorMulti can not record summary only" );
 
-    if( tzone.empty() ) throw std::invalid_argument( "ticks timezone must be set" );
-*/
-    auto n = times.size();
+    bool isParallel = NThreads( nThreads ) > 1 and n > 1;
 
-    Tick tick;
-    Tick tickTrigger;
-    int symbol;
+    // history recorded to R grows R vectors which must not be done outside R main thread
+    if( isParallel ) for( auto processor: processors ) if( processor->historyToR != nullptr ) throw std::invalid_argument( "processors recording history to R can not be fed on more than one thread" );
 
-    for( auto id = 0; id < n; id++ ) {
+    if( isParallel ) FeedParallel( ticks, symbols ); else FeedSequential( ticks, symbols );
 
-      tick.id     = id;
-      tick.time   = times  [id];
-      tick.price  = prices [id];
-      tick.volume = volumes[id];
-      tick.system = false;
+    // every processor ends chunk on its last tick
+    for( int p = 0; p < n; p++ ) if( idLastFed[p] < nTicksFed + (int)nTicks - 1 ) FeedTick( p, ticks, symbols, nTicks - 1 );
 
-      if( hasBid    ) tick.bid    = bids   [id];
-      if( hasAsk    ) tick.ask    = asks   [id];
+    if( not ticks.GetTimeZone().empty() ) portfolio.timeZone = ticks.GetTimeZone();
+    MergePortfolio( ticks );
 
-      symbol = symbols[id];
+    nTicksFed  += nTicks;
+    isFinalized = false;
 
-      tickTrigger.id     = id;
-      tickTrigger.time   = times[id];
-      tickTrigger.system = true;
+  }
 
+  void Finalize() {
 
-      for( int i = 0; i < this->n; i++ ) {
+    for( auto processor: processors ) processor->Finalize();
 
-        processors[ i ]->Feed( symbol == i ? tick : tickTrigger );
+    if( isFinalized ) return;
 
-      }
+    portfolio.Finalize();
+    isFinalized = true;
 
-    }
+  }
+
+  // portfolio of all processors
+  Statistics GetStatistics() { return portfolio; }
+
+  Rcpp::List GetSummary() { return portfolio.GetSummary(); }
+
+  Rcpp::List GetOnDayClosePerformanceHistory() { return portfolio.GetOnDayClosePerformanceHistory(); }
+
+  Rcpp::List GetOnCandlePerformanceHistory() {
+
+    Rcpp::List performance = ListBuilder().AsDataTable()
+      .Add( "time"    , DoubleToDateTime( portfolioCandleTimes, portfolio.timeZone ) )
+      .Add( "pnl"     , portfolio.onCandleHistoryMarketValue.Get()                   )
+      .Add( "drawdown", portfolio.onCandleHistoryDrawDown   .Get()                   );
 
-    for( auto processor: processors ) processor->statistics.Finalize();
+    return performance;
 
   }
 
@@ -27,12 +27,17 @@
 #include "../ListBuilder.h"
 #include "../NPeriods.h"
 #include "../setDT.h"
+#include "../Snapshot.h"
+#include "../SharedVector.h"
 #include <cmath>
+#include <functional>
 #include <Rcpp.h>
 
 class Statistics {
 
+  friend class Test;
   friend class Processor;
+  friend class ProcessorMulti;
 
 public:
 
@@ -77,18 +82,23 @@ private:
 
   bool   isDrawDownMax;
 
-  std::vector<double> onDayCloseHistoryMarketValue;
-  std::vector<double> onDayCloseHistoryMarketValueChange;
-  std::vector<double> onDayCloseHistoryDrawDown;
-  std::vector<int>    onDayCloseHistoryDates;
-  std::vector<int>    onDayCloseHistoryNTrades;
-  std::vector<double> onDayCloseHistoryAvgTradePnl;
+  // histories are shared with statistics copies, see SharedVector
+  SharedVector<double> onDayCloseHistoryMarketValue;
+  SharedVector<double> onDayCloseHistoryMarketValueChange;
+  SharedVector<double> onDayCloseHistoryDrawDown;
+  SharedVector<int>    onDayCloseHistoryDates;
+  SharedVector<int>    onDayCloseHistoryNTrades;
+  SharedVector<double> onDayCloseHistoryAvgTradePnl;
 
   int onDayCloseNTrades;
   double onDayCloseTradePnl;
+  double onDayCloseMarketValue;
 
-  std::vector<double> onCandleHistoryMarketValue;
-  std::vector<double> onCandleHistoryDrawDown;
+  // on day close and on candle histories are not kept, see Processor::RecordSummaryOnly
+  bool isSummaryOnly = false;
+
+  SharedVector<double> onCandleHistoryMarketValue;
+  SharedVector<double> onCandleHistoryDrawDown;
 
   double prevTickTime;
   int date;
@@ -165,8 +175,9 @@ public:
     onDayCloseHistoryDates            .clear();
     onDayCloseHistoryAvgTradePnl      .clear();
     onDayCloseHistoryNTrades          .clear();
-    onDayCloseNTrades  = 0;
-    onDayCloseTradePnl = 0;
+    onDayCloseNTrades     = 0;
+    onDayCloseTradePnl    = 0;
+    onDayCloseMarketValue = 0;
 
     onCandleHistoryMarketValue   .clear();
     onCandleHistoryDrawDown      .clear();
@@ -183,6 +194,80 @@ public:
 
   }
 
+  void Serialize( Snapshot& snapshot ) {
+
+    snapshot.Field( testStart         );
+    snapshot.Field( testEnd           );
+    snapshot.Field( nDaysTested       );
+    snapshot.Field( nDaysTraded       );
+    snapshot.Field( nTradesPerDay     );
+    snapshot.Field( nTradesTotal      );
+    snapshot.Field( nTradesLong       );
+    snapshot.Field( nTradesShort      );
+    snapshot.Field( nTradesWin        );
+    snapshot.Field( nTradesLoss       );
+    snapshot.Field( pTradesWin        );
+    snapshot.Field( pTradesLoss       );
+    snapshot.Field( avgTradeWin       );
+    snapshot.Field( avgTradeLoss      );
+    snapshot.Field( avgTradePnl       );
+    snapshot.Field( totalWin          );
+    snapshot.Field( totalLoss         );
+    snapshot.Field( totalPnl          );
+    snapshot.Field( maxDrawDown       );
+    snapshot.Field( maxDrawDownStart  );
+    snapshot.Field( maxDrawDownEnd    );
+    snapshot.Field( maxDrawDownLength );
+    snapshot.Field( sharpe            );
+    snapshot.Field( sortino           );
+    snapshot.Field( rSquared          );
+    snapshot.Field( avgDrawDown       );
+
+    snapshot.Field( positionPlanned   );
+    snapshot.Field( position          );
+    snapshot.Field( positionValue     );
+
+    snapshot.Field( drawDown          );
+    snapshot.Field( drawDownStart     );
+    snapshot.Field( drawDownEnd       );
+    snapshot.Field( marketValue       );
+    snapshot.Field( marketValueMax    );
+
+    snapshot.Field( isDrawDownMax     );
+
+    onDayCloseHistoryMarketValue      .Serialize( snapshot );
+    onDayCloseHistoryMarketValueChange.Serialize( snapshot );
+    onDayCloseHistoryDrawDown         .Serialize( snapshot );
+    onDayCloseHistoryDates            .Serialize( snapshot );
+    onDayCloseHistoryNTrades          .Serialize( snapshot );
+    onDayCloseHistoryAvgTradePnl      .Serialize( snapshot );
+    snapshot.Field( onDayCloseNTrades     );
+    snapshot.Field( onDayCloseTradePnl    );
+    snapshot.Field( onDayCloseMarketValue );
+    snapshot.Field( isSummaryOnly         );
+
+    onCandleHistoryMarketValue.Serialize( snapshot );
+    onCandleHistoryDrawDown   .Serialize( snapshot );
+
+    snapshot.Field( prevTickTime );
+    snapshot.Field( date         );
+
+    snapshot.Field( sumV  );
+    snapshot.Field( sumVV );
+    snapshot.Field( sumNV );
+    snapshot.Field( sumR  );
+    snapshot.Field( sumRR );
+    snapshot.Field( tdv   );
+
+    snapshot.Field( executionType );
+    snapshot.Field( bid           );
+    snapshot.Field( ask           );
+
+    snapshot.Field( nTradingDaysInYear );
+    snapshot.Field( timeZone           );
+
+  }
+
   void Update( double timeTrade ) {
 
     int date = timeTrade / nSecondsInDay;
@@ -283,15 +368,20 @@ public:
 
   void onDayStart() { // previous day close
 
-    onDayCloseHistoryDates.push_back( prevTickTime / nSecondsInDay );
+    double marketValueChange = nDaysTested == 0 ? marketValue : marketValue - onDayCloseMarketValue;
 
-    double marketValueChange = nDaysTested == 0 ? marketValue : marketValue - onDayCloseHistoryMarketValue.back();
+    onDayCloseMarketValue = marketValue;
 
-    onDayCloseHistoryMarketValueChange.push_back( marketValueChange );
-    onDayCloseHistoryMarketValue      .push_back( marketValue );
-    onDayCloseHistoryDrawDown         .push_back( drawDown );
-    onDayCloseHistoryAvgTradePnl      .push_back( onDayCloseNTrades == 0 ? 0 : onDayCloseTradePnl / onDayCloseNTrades );
-    onDayCloseHistoryNTrades          .push_back( onDayCloseNTrades );
+    if( not isSummaryOnly ) {
+
+      onDayCloseHistoryDates            .push_back( prevTickTime / nSecondsInDay );
+      onDayCloseHistoryMarketValueChange.push_back( marketValueChange );
+      onDayCloseHistoryMarketValue      .push_back( marketValue );
+      onDayCloseHistoryDrawDown         .push_back( drawDown );
+      onDayCloseHistoryAvgTradePnl      .push_back( onDayCloseNTrades == 0 ? 0 : onDayCloseTradePnl / onDayCloseNTrades );
+      onDayCloseHistoryNTrades          .push_back( onDayCloseNTrades );
+
+    }
 
     nDaysTested++;
 
@@ -333,11 +423,7 @@ public:
 
   void Update( const Tick& tick ) {
 
-    if( prevTickTime == 0 ) { testStart = tick.time; } else {
-
-      if( NNights( prevTickTime, tick.time ) > 0 ) onDayStart();
-
-    }
+    OnTime( tick.time );
 
     if( not tick.system ) {
 
@@ -354,6 +440,42 @@ public:
 
     }
 
+    OnMarketValue( tick.time );
+
+    if( executionType == ExecutionType::BBO and not tick.system ) {
+
+      bid = tick.bid;
+      ask = tick.ask;
+
+    }
+
+  }
+
+  // market value set by caller instead of position, used for portfolio of many processors
+  void Update( double time, double marketValue ) {
+
+    OnTime( time );
+
+    this->marketValue = marketValue;
+
+    OnMarketValue( time );
+
+  }
+
+private:
+
+  void OnTime( double time ) {
+
+    if( prevTickTime == 0 ) { testStart = time; } else {
+
+      if( NNights( prevTickTime, time ) > 0 ) onDayStart();
+
+    }
+
+  }
+
+  void OnMarketValue( double time ) {
+
     if( marketValueMax < marketValue ) marketValueMax = marketValue;
 
     double prevDrowdown = drawDown;
@@ -362,7 +484,7 @@ public:
     bool isDrawDownStarted = prevDrowdown == 0 and drawDown < 0;
     if( isDrawDownStarted ) {
 
-      drawDownStart = tick.time;
+      drawDownStart = time;
       drawDownEnd   = NAN;
 
     }
@@ -370,7 +492,7 @@ public:
     bool isDrawDownEnded = prevDrowdown < 0 and drawDown == 0;
     if( isDrawDownEnded ) {
 
-      drawDownEnd = tick.time;
+      drawDownEnd = time;
 
     }
 
@@ -394,22 +516,19 @@ public:
 
     }
 
-    prevTickTime = tick.time;
-    testEnd = tick.time;
+    prevTickTime = time;
+    testEnd = time;
 
     nTradesPerDay = nTradesTotal * 1.0 / nDaysTraded;
 
-    if( executionType == ExecutionType::BBO and not tick.system ) {
-
-      bid = tick.bid;
-      ask = tick.ask;
-
-    }
-
   }
 
+public:
+
   void Update( Candle& candle ) {
 
+    if( isSummaryOnly ) return;
+
     if( std::isnan( marketValue ) ) {
 
       onCandleHistoryMarketValue.push_back( 0 );
@@ -424,40 +543,74 @@ public:
 
   }
 
-  Rcpp::List GetSummary() {
+  Rcpp::List GetOnDayClosePerformanceHistory() {
+
+    Rcpp::List performance = ListBuilder().AsDataTable()
+      .Add( "date"     , IntToDate( onDayCloseHistoryDates.Get() ) )
+      .Add( "return"   , onDayCloseHistoryMarketValueChange.Get()  )
+      .Add( "pnl"      , onDayCloseHistoryMarketValue      .Get()  )
+      .Add( "drawdown" , onDayCloseHistoryDrawDown         .Get()  )
+      .Add( "avg_pnl"  , onDayCloseHistoryAvgTradePnl      .Get()  )
+      .Add( "n_per_day", onDayCloseHistoryNTrades          .Get()  );
+
+    return performance;
+
+  }
+
+  Rcpp::List GetSummary() { return GetSummary( { this } ); }
+
+  // one summary row per statistics object, used to combine parameter sweep results
+  static Rcpp::List GetSummary( const std::vector< const Statistics* >& statistics ) {
 
     double percents    = 100;
     double basisPoints = 10000;
     double epsilon     = 0.01;
 
+    std::string timeZone = statistics.empty() ? "UTC" : statistics[0]->timeZone;
+
+    auto real = [&]( std::function< double( const Statistics* ) > value, double scale ) {
+
+      std::vector< double > x;
+      for( auto s: statistics ) x.push_back( scale == 0 ? value( s ) : std::round( value( s ) * scale / epsilon ) * epsilon );
+      return x;
+
+    };
+    auto integer = [&]( std::function< int( const Statistics* ) > value ) {
+
+      std::vector< int > x;
+      for( auto s: statistics ) x.push_back( value( s ) );
+      return x;
+
+    };
+
     Rcpp::List summary = ListBuilder().AsDataTable()
 
-      .Add( "from"          , DoubleToDateTime( testStart, timeZone )                      )
-      .Add( "to"            , DoubleToDateTime( testEnd  , timeZone )                      )
-      .Add( "days_tested"   , nDaysTested                                                  )
-      .Add( "days_traded"   , nDaysTraded                                                  )
-      .Add( "n_per_day"     , std::round( nTradesPerDay / epsilon ) * epsilon              )
-      .Add( "n"             , nTradesTotal                                                 )
-      .Add( "n_long"        , nTradesLong                                                  )
-      .Add( "n_short"       , nTradesShort                                                 )
-      .Add( "n_win"         , nTradesWin                                                   )
-      .Add( "n_loss"        , nTradesLoss                                                  )
-      .Add( "pct_win"       , std::round( pTradesWin   * percents    / epsilon ) * epsilon )
-      .Add( "pct_loss"      , std::round( pTradesLoss  * percents    / epsilon ) * epsilon )
-      .Add( "avg_win"       , std::round( avgTradeWin  * basisPoints / epsilon ) * epsilon )
-      .Add( "avg_loss"      , std::round( avgTradeLoss * basisPoints / epsilon ) * epsilon )
-      .Add( "avg_pnl"       , std::round( avgTradePnl  * basisPoints / epsilon ) * epsilon )
-      .Add( "win"           , std::round( totalWin     * percents    / epsilon ) * epsilon )
-      .Add( "loss"          , std::round( totalLoss    * percents    / epsilon ) * epsilon )
-      .Add( "pnl"           , std::round( totalPnl     * percents    / epsilon ) * epsilon )
-      .Add( "max_dd"        , std::round( maxDrawDown  * percents    / epsilon ) * epsilon )
-      .Add( "max_dd_start"  , DoubleToDateTime( maxDrawDownStart, timeZone )               )
-      .Add( "max_dd_end"    , DoubleToDateTime( maxDrawDownEnd  , timeZone )               )
-      .Add( "max_dd_length" , maxDrawDownLength                                            )
-      .Add( "sharpe"        , std::round( sharpe   / epsilon ) * epsilon                   )
-      .Add( "sortino"       , std::round( sortino  / epsilon ) * epsilon                   )
-      .Add( "r_squared"     , std::round( rSquared / epsilon ) * epsilon                   )
-      .Add( "avg_dd"        , std::round( avgDrawDown  * percents / epsilon ) * epsilon    );
+      .Add( "from"          , DoubleToDateTime( real( []( const Statistics* s ) { return s->testStart;         }, 0 ), timeZone ) )
+      .Add( "to"            , DoubleToDateTime( real( []( const Statistics* s ) { return s->testEnd;           }, 0 ), timeZone ) )
+      .Add( "days_tested"   , integer( []( const Statistics* s ) { return s->nDaysTested;                        } )              )
+      .Add( "days_traded"   , integer( []( const Statistics* s ) { return s->nDaysTraded;                        } )              )
+      .Add( "n_per_day"     , real( []( const Statistics* s ) { return s->nTradesPerDay;     }, 1           )                     )
+      .Add( "n"             , integer( []( const Statistics* s ) { return s->nTradesTotal;                       } )              )
+      .Add( "n_long"        , integer( []( const Statistics* s ) { return s->nTradesLong;                        } )              )
+      .Add( "n_short"       , integer( []( const Statistics* s ) { return s->nTradesShort;                       } )              )
+      .Add( "n_win"         , integer( []( const Statistics* s ) { return s->nTradesWin;                         } )              )
+      .Add( "n_loss"        , integer( []( const Statistics* s ) { return s->nTradesLoss;                        } )              )
+      .Add( "pct_win"       , real( []( const Statistics* s ) { return s->pTradesWin;        }, percents    )                     )
+      .Add( "pct_loss"      , real( []( const Statistics* s ) { return s->pTradesLoss;       }, percents    )                     )
+      .Add( "avg_win"       , real( []( const Statistics* s ) { return s->avgTradeWin;       }, basisPoints )                     )
+      .Add( "avg_loss"      , real( []( const Statistics* s ) { return s->avgTradeLoss;      }, basisPoints )                     )
+      .Add( "avg_pnl"       , real( []( const Statistics* s ) { return s->avgTradePnl;       }, basisPoints )                     )
+      .Add( "win"           , real( []( const Statistics* s ) { return s->totalWin;          }, percents    )                     )
+      .Add( "loss"          , real( []( const Statistics* s ) { return s->totalLoss;         }, percents    )                     )
+      .Add( "pnl"           , real( []( const Statistics* s ) { return s->totalPnl;          }, percents    )                     )
+      .Add( "max_dd"        , real( []( const Statistics* s ) { return s->maxDrawDown;       }, percents    )                     )
+      .Add( "max_dd_start"  , DoubleToDateTime( real( []( const Statistics* s ) { return s->maxDrawDownStart;  }, 0 ), timeZone ) )
+      .Add( "max_dd_end"    , DoubleToDateTime( real( []( const Statistics* s ) { return s->maxDrawDownEnd;    }, 0 ), timeZone ) )
+      .Add( "max_dd_length" , real( []( const Statistics* s ) { return s->maxDrawDownLength; }, 0           )                     )
+      .Add( "sharpe"        , real( []( const Statistics* s ) { return s->sharpe;            }, 1           )                     )
+      .Add( "sortino"       , real( []( const Statistics* s ) { return s->sortino;           }, 1           )                     )
+      .Add( "r_squared"     , real( []( const Statistics* s ) { return s->rSquared;          }, 1           )                     )
+      .Add( "avg_dd"        , real( []( const Statistics* s ) { return s->avgDrawDown;       }, percents    )                     );
 
       return summary;
 
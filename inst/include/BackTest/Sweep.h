@@ -0,0 +1,131 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "Processor.h"
+#include "../Parallel.h"
+#include "../ListBuilder.h"
+#include <map>
+#include <string>
+#include <vector>
+#include <Rcpp.h>
+
+class Sweep {
+
+public:
+
+  typedef std::map< std::string, double > Parameters;
+
+  // sets up strategy on processor and feeds ticks, called on worker thread so must not call R API
+  // processor records summary only so orders must not be accessed after they are executed or cancelled, see Processor::RecordSummaryOnly
+  typedef std::function< void( Processor& bt, const Parameters& parameters, const Ticks& ticks ) > Strategy;
+
+private:
+
+  // decoded once and shared read only by all runs
+  Ticks ticks;
+
+  Rcpp::DataFrame parametersGrid;
+  std::vector< Parameters > parameters;
+  std::vector< Processor* > processors;
+  std::vector< Statistics > statistics;
+  bool isRun = false;
+
+  void Clear() {
+
+    for( auto processor: processors ) delete processor;
+    processors.clear();
+
+  }
+
+public:
+
+  Sweep( Rcpp::DataFrame ticks, Rcpp::DataFrame parameters, Rcpp::List options ) :
+
+    ticks( ticks ),
+    parametersGrid( parameters )
+
+  {
+
+    Rcpp::StringVector parameterNames = parameters.attr( "names" );
+
+    bool hasTimeFrame = std::find( parameterNames.begin(), parameterNames.end(), "timeframe" ) != parameterNames.end();
+    if( !hasTimeFrame ) throw std::invalid_argument( "parameters must contain 'timeframe' column" );
+
+    int nRuns = parameters.nrows();
+
+    this->parameters.resize( nRuns );
+
+    for( int j = 0; j < parameterNames.size(); j++ ) {
+
+      std::string name = Rcpp::as< std::string >( parameterNames[j] );
+      Rcpp::NumericVector values = parameters[j];
+
+      for( int i = 0; i < nRuns; i++ ) this->parameters[i][name] = values[i];
+
+    }
+
+    // options are R objects so processors are configured here and not in worker threads
+    for( int i = 0; i < nRuns; i++ ) {
+
+      Processor* processor = new Processor( this->parameters[i][ "timeframe" ] );
+      processor->SetOptions( options );
+      processor->RecordSummaryOnly();
+      processors.push_back( processor );
+
+    }
+
+  }
+
+  ~Sweep() { Clear(); }
+
+  // runs strategy for every parameters row on nThreads threads ( 0 = all cores )
+  // returns parameters with summary columns appended
+  Rcpp::List Run( Strategy strategy, int nThreads = 0 ) {
+
+    // processors are released by the first run even if strategy throws
+    if( isRun ) throw std::logic_error( "sweep can only be run once" );
+    isRun = true;
+
+    statistics.resize( parameters.size() );
+
+    ParallelFor( parameters.size(), nThreads, [&]( std::size_t i ) {
+
+      strategy( *processors[i], parameters[i], ticks );
+      statistics[i] = processors[i]->GetStatistics();
+
+    } );
+
+    // processors are released on calling thread
+    Clear();
+
+    std::vector< const Statistics* > summaries;
+    for( auto& s: statistics ) summaries.push_back( &s );
+
+    Rcpp::List summary = ListBuilder().AsDataTable()
+      .Add( parametersGrid )
+      .Add( Statistics::GetSummary( summaries ) );
+
+    return summary;
+
+  }
+
+};
+
+#endif //SWEEP_H
@@ -0,0 +1,374 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef TICKFILE_H
+#define TICKFILE_H
+
+#include "Ticks.h"
+#include <cmath>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// binary columnar tick file with per day index
+// read by memory mapping, ticks are not copied or decoded
+//
+// layout ( native byte order, every block starts at 64 bytes boundary ):
+//   header   : magic "QTTICKS1", int32 flags ( 1 = bid, 2 = ask ), int32 number of days, int64 number of ticks
+//   index    : number of days x { int32 date ( days since 1970-01-01 UTC ), int32 unused, int64 first tick }
+//   columns  : double time[n], double price[n], int32 volume[n], double bid[n], double ask[n]
+class TickFile {
+
+private:
+
+  static constexpr std::size_t alignment = 64;
+  static constexpr const char* magic = "QTTICKS1";
+
+  enum Flags: int32_t { BID = 1, ASK = 2 };
+
+  struct Header {
+
+    char    magic[8];
+    int32_t flags;
+    int32_t nDays;
+    int64_t nTicks;
+
+  };
+
+  struct Day {
+
+    int32_t date;
+    int32_t unused;
+    int64_t from;
+
+  };
+
+  static std::size_t Aligned( std::size_t size ) { return ( size + alignment - 1 ) / alignment * alignment; }
+
+  std::string path;
+  std::shared_ptr< char > map;
+  std::size_t mapSize = 0;
+
+  Header header;
+  std::vector< int >     dates;
+  std::vector< int64_t > starts; // first tick of each day and number of ticks at the end
+
+  const double* time   = nullptr;
+  const double* price  = nullptr;
+  const int*    volume = nullptr;
+  const double* bid    = nullptr;
+  const double* ask    = nullptr;
+
+  void Map() {
+
+#ifdef _WIN32
+
+    HANDLE file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    if( file == INVALID_HANDLE_VALUE ) throw std::runtime_error( "cannot open tick file " + path );
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx( file, &fileSize );
+    mapSize = fileSize.QuadPart;
+
+    if( mapSize < sizeof( Header ) ) { CloseHandle( file ); throw std::runtime_error( "not a tick file " + path ); }
+
+    HANDLE mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+    CloseHandle( file );
+    if( mapping == NULL ) throw std::runtime_error( "cannot map tick file " + path );
+
+    char* data = (char*)MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+    CloseHandle( mapping );
+    if( data == NULL ) throw std::runtime_error( "cannot map tick file " + path );
+
+    map = std::shared_ptr< char >( data, []( char* data ) { UnmapViewOfFile( data ); } );
+
+#else
+
+    int file = open( path.c_str(), O_RDONLY );
+    if( file < 0 ) throw std::runtime_error( "cannot open tick file " + path );
+
+    struct stat fileStat;
+    fstat( file, &fileStat );
+    mapSize = fileStat.st_size;
+
+    if( mapSize < sizeof( Header ) ) { close( file ); throw std::runtime_error( "not a tick file " + path ); }
+
+    void* data = mmap( NULL, mapSize, PROT_READ, MAP_SHARED, file, 0 );
+    close( file );
+    if( data == MAP_FAILED ) throw std::runtime_error( "cannot map tick file " + path );
+
+    std::size_t length = mapSize;
+    map = std::shared_ptr< char >( (char*)data, [length]( char* data ) { munmap( data, length ); } );
+
+#endif
+
+  }
+
+  void Read() {
+
+    std::memcpy( &header, map.get(), sizeof( Header ) );
+
+    if( std::strncmp( header.magic, magic, 8 ) != 0 ) throw std::runtime_error( "not a tick file " + path );
+
+    std::size_t n = header.nTicks;
+
+    std::size_t offset = Aligned( sizeof( Header ) );
+    std::size_t offsetColumns = offset + Aligned( header.nDays * sizeof( Day ) );
+
+    std::size_t sizeDouble = Aligned( n * sizeof( double  ) );
+    std::size_t sizeInt    = Aligned( n * sizeof( int32_t ) );
+
+    std::size_t sizeExpected = offsetColumns + sizeDouble * ( 2 + ( header.flags & BID ? 1 : 0 ) + ( header.flags & ASK ? 1 : 0 ) ) + sizeInt;
+    if( mapSize < sizeExpected ) throw std::runtime_error( "tick file is truncated " + path );
+
+    const Day* days = reinterpret_cast< const Day* >( map.get() + offset );
+
+    for( int i = 0; i < header.nDays; i++ ) {
+
+      dates .push_back( days[i].date );
+      starts.push_back( days[i].from );
+
+    }
+    starts.push_back( n );
+
+    char* p = map.get() + offsetColumns;
+
+    time   = reinterpret_cast< const double* >( p ); p += sizeDouble;
+    price  = reinterpret_cast< const double* >( p ); p += sizeDouble;
+    volume = reinterpret_cast< const int*    >( p ); p += sizeInt;
+    if( header.flags & BID ) { bid = reinterpret_cast< const double* >( p ); p += sizeDouble; }
+    if( header.flags & ASK ) { ask = reinterpret_cast< const double* >( p ); p += sizeDouble; }
+
+  }
+
+  // pads block of given size to alignment
+  static void Pad( std::ofstream& file, std::size_t size ) {
+
+    static const char zeros[ alignment ] = {};
+
+    file.write( zeros, Aligned( size ) - size );
+
+  }
+
+  static void WriteBlock( std::ofstream& file, const void* data, std::size_t size ) {
+
+    file.write( (const char*)data, size );
+    Pad( file, size );
+
+  }
+
+public:
+
+  TickFile( std::string path ) : path( path ) {
+
+    Map();
+    Read();
+
+  }
+
+  static int ToDate( double time ) { return std::floor( time / 86400 ); }
+
+  // "YYYY-mm-dd" to days since 1970-01-01
+  static int ToDate( std::string date ) {
+
+    int y, m, d;
+    if( std::sscanf( date.c_str(), "%d-%d-%d", &y, &m, &d ) != 3 ) throw std::invalid_argument( "date must be in format YYYY-mm-dd" );
+
+    y -= m <= 2;
+    int era = ( y >= 0 ? y : y - 399 ) / 400;
+    int yoe = y - era * 400;
+    int doy = ( 153 * ( m + ( m > 2 ? -3 : 9 ) ) + 2 ) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return era * 146097 + doe - 719468;
+
+  }
+
+  std::vector< int > GetDates() const { return dates; }
+
+  std::size_t size() const { return header.nTicks; }
+
+  bool HasBid() const { return bid != nullptr; }
+  bool HasAsk() const { return ask != nullptr; }
+
+  // ticks of dates in [ from, to ] without copying, view keeps file mapped while in use
+  Ticks Get( int from = INT32_MIN, int to = INT32_MAX ) const {
+
+    auto first = std::lower_bound( dates.begin(), dates.end(), from ) - dates.begin();
+    auto last  = std::upper_bound( dates.begin(), dates.end(), to   ) - dates.begin();
+
+    std::size_t i = starts[ first ];
+    std::size_t j = last > first ? starts[ last ] : i;
+
+    Ticks ticks( j - i, time + i, price + i, volume + i, bid == nullptr ? nullptr : bid + i, ask == nullptr ? nullptr : ask + i, nullptr, map );
+    ticks.SetTimeZone( "UTC" );
+
+    return ticks;
+
+  }
+
+  // writes ticks to file, ticks already in file within time span of new ticks are replaced and the rest are kept
+  // file is written to temporary file first and then renamed so readers never see partial file
+  static void Write( std::string path, const Ticks& ticks ) {
+
+    const double* time = ticks.GetTime();
+    std::size_t n = ticks.size();
+
+    for( std::size_t i = 1; i < n; i++ ) if( time[i] < time[ i - 1 ] ) throw std::invalid_argument( "ticks must be time ordered" );
+
+    if( n == 0 ) return;
+
+    // output is up to three contiguous parts: existing ticks before new ones, new ticks, existing ticks after new ones
+    struct Part { const Ticks* source; std::size_t from; std::size_t to; };
+    std::vector< Part > parts;
+
+    Ticks existing;
+    std::unique_ptr< TickFile > file;
+
+    std::ifstream test( path.c_str() );
+    if( test.good() ) {
+
+      test.close();
+
+      file.reset( new TickFile( path ) );
+      existing = file->Get();
+
+    }
+
+    const double* timeExisting = existing.GetTime();
+    std::size_t nExisting = existing.size();
+
+    std::size_t before = std::lower_bound( timeExisting, timeExisting + nExisting, time[0]     ) - timeExisting;
+    std::size_t after  = std::upper_bound( timeExisting, timeExisting + nExisting, time[n - 1] ) - timeExisting;
+
+    if( before > 0         ) parts.push_back( { &existing, 0    , before    } );
+    parts.push_back( { &ticks, 0, n } );
+    if( after  < nExisting ) parts.push_back( { &existing, after, nExisting } );
+
+    // bid and ask are kept if any part has them, parts without them are filled with NA
+    bool hasBid = false;
+    bool hasAsk = false;
+    for( auto& part: parts ) {
+
+      hasBid = hasBid or part.source->HasBid();
+      hasAsk = hasAsk or part.source->HasAsk();
+
+    }
+
+    Header header;
+    std::memcpy( header.magic, magic, 8 );
+    header.flags  = ( hasBid ? BID : 0 ) | ( hasAsk ? ASK : 0 );
+    header.nTicks = 0;
+
+    std::vector< Day > days;
+    for( auto& part: parts ) {
+
+      const double* t = part.source->GetTime();
+
+      for( std::size_t i = part.from; i < part.to; i++, header.nTicks++ ) {
+
+        int date = ToDate( t[i] );
+        if( days.empty() or days.back().date != date ) days.push_back( { date, 0, header.nTicks } );
+
+      }
+
+    }
+
+    header.nDays = days.size();
+
+    std::string pathTemp = path + ".tmp";
+
+    {
+
+      std::ofstream out( pathTemp.c_str(), std::ios::binary | std::ios::trunc );
+      if( not out.good() ) throw std::runtime_error( "cannot write tick file " + path );
+
+      WriteBlock( out, &header, sizeof( Header ) );
+      WriteBlock( out, days.data(), days.size() * sizeof( Day ) );
+
+      auto writeColumn = [&]( std::size_t width, std::function< const char*( const Ticks* ) > column ) {
+
+        std::size_t size = 0;
+        for( auto& part: parts ) {
+
+          const char* data = column( part.source );
+
+          if( data == nullptr ) {
+
+            std::vector< double > na( part.to - part.from, NA_REAL );
+            out.write( (const char*)na.data(), na.size() * width );
+
+          } else {
+
+            out.write( data + part.from * width, ( part.to - part.from ) * width );
+
+          }
+          size += ( part.to - part.from ) * width;
+
+        }
+        Pad( out, size );
+
+      };
+
+      writeColumn( sizeof( double  ), []( const Ticks* t ) { return (const char*)t->GetTime();   } );
+      writeColumn( sizeof( double  ), []( const Ticks* t ) { return (const char*)t->GetPrice();  } );
+      writeColumn( sizeof( int32_t ), []( const Ticks* t ) { return (const char*)t->GetVolume(); } );
+      if( hasBid ) writeColumn( sizeof( double ), []( const Ticks* t ) { return (const char*)t->GetBid(); } );
+      if( hasAsk ) writeColumn( sizeof( double ), []( const Ticks* t ) { return (const char*)t->GetAsk(); } );
+
+      if( not out.good() ) throw std::runtime_error( "cannot write tick file " + path );
+
+    }
+
+    // release existing file before replacing it
+    existing = Ticks();
+    file.reset();
+
+    // replaces existing file in one step so it is kept if new one can not be moved in place
+#ifdef _WIN32
+    bool isReplaced = MoveFileExA( pathTemp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING ) != 0;
+#else
+    bool isReplaced = std::rename( pathTemp.c_str(), path.c_str() ) == 0;
+#endif
+    if( not isReplaced ) {
+
+      std::remove( pathTemp.c_str() );
+      throw std::runtime_error( "cannot write tick file " + path );
+
+    }
+
+  }
+
+};
+
+#endif //TICKFILE_H
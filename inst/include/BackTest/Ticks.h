@@ -0,0 +1,196 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef TICKS_H
+#define TICKS_H
+
+#include "Tick.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <Rcpp.h>
+
+// immutable columnar tick storage
+// built once from data.frame and then read by any number of processors in any number of threads
+// columns are cache line aligned, missing bid, ask and system columns are not allocated
+class Ticks {
+
+private:
+
+  static constexpr std::size_t alignment = 64;
+
+  std::shared_ptr< char > storage;
+
+  std::size_t n      = 0;
+  int         idFrom = 0; // id of the first tick, non zero for slices
+
+  const double* time   = nullptr;
+  const double* price  = nullptr;
+  const int*    volume = nullptr;
+  const double* bid    = nullptr;
+  const double* ask    = nullptr;
+  const bool*   system = nullptr;
+
+  std::string timeZone;
+
+  static std::size_t Aligned( std::size_t size ) { return ( size + alignment - 1 ) / alignment * alignment; }
+
+public:
+
+  Ticks() {}
+
+  // view over columns owned by someone else, storage keeps them alive if set
+  Ticks( std::size_t n, const double* time, const double* price, const int* volume, const double* bid, const double* ask, const bool* system, std::shared_ptr< char > storage = nullptr ) :
+
+    storage( storage ),
+    n      ( n       ),
+    time   ( time    ),
+    price  ( price   ),
+    volume ( volume  ),
+    bid    ( bid     ),
+    ask    ( ask     ),
+    system ( system  )
+
+  {}
+
+  Ticks( Rcpp::DataFrame ticks ) {
+
+    Rcpp::StringVector names = ticks.attr( "names" );
+
+    bool hasTime   = std::find( names.begin(), names.end(), "time"   ) != names.end();
+    bool hasPrice  = std::find( names.begin(), names.end(), "price"  ) != names.end();
+    bool hasVolume = std::find( names.begin(), names.end(), "volume" ) != names.end();
+
+    bool hasBid    = std::find( names.begin(), names.end(), "bid"    ) != names.end();
+    bool hasAsk    = std::find( names.begin(), names.end(), "ask"    ) != names.end();
+    bool hasSystem = std::find( names.begin(), names.end(), "system" ) != names.end();
+
+    if( !hasTime   ) throw std::invalid_argument( "ticks must contain 'time' column"   );
+    if( !hasPrice  ) throw std::invalid_argument( "ticks must contain 'price' column"  );
+    if( !hasVolume ) throw std::invalid_argument( "ticks must contain 'volume' column" );
+
+    Rcpp::NumericVector  bids;
+    Rcpp::NumericVector  asks;
+    Rcpp::LogicalVector  systems;
+
+    Rcpp::NumericVector  times   = ticks[ "time"   ];
+    Rcpp::NumericVector  prices  = ticks[ "price"  ];
+    Rcpp::IntegerVector  volumes = ticks[ "volume" ];
+    if( hasBid    )      bids    = ticks[ "bid"    ];
+    if( hasAsk    )      asks    = ticks[ "ask"    ];
+    if( hasSystem )      systems = ticks[ "system" ];
+
+    std::vector<std::string> tzone = times.attr( "tzone" );
+    if( not tzone.empty() ) timeZone = tzone[0];
+
+    Allocate( times.size(), hasBid, hasAsk, hasSystem );
+
+    std::copy( times  .begin(), times  .end(), const_cast< double* >( time   ) );
+    std::copy( prices .begin(), prices .end(), const_cast< double* >( price  ) );
+    std::copy( volumes.begin(), volumes.end(), const_cast< int*    >( volume ) );
+    if( hasBid    ) std::copy( bids.begin(), bids.end(), const_cast< double* >( bid ) );
+    if( hasAsk    ) std::copy( asks.begin(), asks.end(), const_cast< double* >( ask ) );
+    if( hasSystem ) for( std::size_t i = 0; i < n; i++ ) const_cast< bool* >( system )[i] = systems[i];
+
+  }
+
+  // allocates all columns in single aligned block
+  void Allocate( std::size_t n, bool hasBid, bool hasAsk, bool hasSystem ) {
+
+    std::size_t sizeDouble = Aligned( n * sizeof( double ) );
+    std::size_t sizeInt    = Aligned( n * sizeof( int    ) );
+    std::size_t sizeBool   = Aligned( n * sizeof( bool   ) );
+
+    std::size_t size = sizeDouble * ( 2 + hasBid + hasAsk ) + sizeInt + sizeBool * hasSystem;
+
+    storage = std::shared_ptr< char >( new char[ size + alignment ], std::default_delete< char[] >() );
+
+    char* p = storage.get();
+    p += ( alignment - reinterpret_cast< std::uintptr_t >( p ) % alignment ) % alignment;
+
+    this->n = n;
+    idFrom  = 0;
+
+    time   = reinterpret_cast< double* >( p ); p += sizeDouble;
+    price  = reinterpret_cast< double* >( p ); p += sizeDouble;
+    volume = reinterpret_cast< int*    >( p ); p += sizeInt;
+    bid    = nullptr;
+    ask    = nullptr;
+    system = nullptr;
+    if( hasBid    ) { bid    = reinterpret_cast< double* >( p ); p += sizeDouble; }
+    if( hasAsk    ) { ask    = reinterpret_cast< double* >( p ); p += sizeDouble; }
+    if( hasSystem ) { system = reinterpret_cast< bool*   >( p ); p += sizeBool;   }
+
+  }
+
+  std::size_t size() const { return n; }
+
+  bool HasBid()    const { return bid    != nullptr; }
+  bool HasAsk()    const { return ask    != nullptr; }
+  bool HasSystem() const { return system != nullptr; }
+
+  const double* GetTime()   const { return time;   }
+  const double* GetPrice()  const { return price;  }
+  const int*    GetVolume() const { return volume; }
+  const double* GetBid()    const { return bid;    }
+  const double* GetAsk()    const { return ask;    }
+  const bool*   GetSystem() const { return system; }
+
+  std::string GetTimeZone() const { return timeZone; }
+  void SetTimeZone( std::string timeZone ) { this->timeZone = timeZone; }
+
+  // fills tick without allocation, tick id is row number in original ticks
+  void Get( std::size_t i, Tick& tick ) const {
+
+    tick.id     = idFrom + i;
+    tick.time   = time  [i];
+    tick.price  = price [i];
+    tick.volume = volume[i];
+    tick.bid    = bid    == nullptr ? 0.    : bid   [i];
+    tick.ask    = ask    == nullptr ? 0.    : ask   [i];
+    tick.system = system == nullptr ? false : system[i];
+
+  }
+
+  Tick operator[]( std::size_t i ) const { Tick tick; Get( i, tick ); return tick; }
+
+  // rows [from, to) sharing the same storage
+  Ticks Slice( std::size_t from, std::size_t to ) const {
+
+    if( from > to or to > n ) throw std::out_of_range( "ticks slice out of range" );
+
+    Ticks slice = *this;
+
+    slice.n      = to - from;
+    slice.idFrom = idFrom + from;
+    slice.time   = time   + from;
+    slice.price  = price  + from;
+    slice.volume = volume + from;
+    if( bid    != nullptr ) slice.bid    = bid    + from;
+    if( ask    != nullptr ) slice.ask    = ask    + from;
+    if( system != nullptr ) slice.system = system + from;
+
+    return slice;
+
+  }
+
+};
+
+#endif //TICKS_H
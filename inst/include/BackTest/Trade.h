@@ -18,6 +18,8 @@
 #ifndef TRADE_H
 #define TRADE_H
 
+#include "../Snapshot.h"
+
 enum class TradeSide: int { LONG, SHORT };
 
 enum class TradeState: int { NEW, OPENED, CLOSED, CLOSING };
@@ -49,6 +51,8 @@ class Trade {
     double mtmMaxRel  = 0;
     double costRel    = 0;
 
+    bool isShared = false; // closed trade referenced by forked processors, see Processor::Fork
+
     bool IsOpened() { return state == TradeState::OPENED; }
     bool IsClosed() { return state == TradeState::CLOSED; }
     bool IsClosing(){ return state == TradeState::CLOSING;}
@@ -56,6 +60,32 @@ class Trade {
     bool IsLong()   { return side  == TradeSide::LONG;    }
     bool IsShort()  { return side  == TradeSide::SHORT;   }
 
+    void Serialize( Snapshot& snapshot ) {
+
+      snapshot.Field( state      );
+      snapshot.Field( idTrade    );
+      snapshot.Field( idSent     );
+      snapshot.Field( idEnter    );
+      snapshot.Field( idExit     );
+      snapshot.Field( side       );
+      snapshot.Field( priceEnter );
+      snapshot.Field( priceExit  );
+      snapshot.Field( timeSent   );
+      snapshot.Field( timeEnter  );
+      snapshot.Field( timeExit   );
+      snapshot.Field( pnl        );
+      snapshot.Field( mtm        );
+      snapshot.Field( mtmMin     );
+      snapshot.Field( mtmMax     );
+      snapshot.Field( cost       );
+      snapshot.Field( pnlRel     );
+      snapshot.Field( mtmRel     );
+      snapshot.Field( mtmMinRel  );
+      snapshot.Field( mtmMaxRel  );
+      snapshot.Field( costRel    );
+
+    }
+
 };
 
 #endif //TRADE_H
@@ -0,0 +1,94 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef COLUMNBUFFER_H
+#define COLUMNBUFFER_H
+
+#include <algorithm>
+#include <vector>
+#include <Rcpp.h>
+#include "Snapshot.h"
+
+// growable R vector filled from C++ and returned to R without conversion
+// capacity doubles on growth, if buffer is full on Get the vector itself is returned otherwise only the filled part is copied once
+// allocates R memory so must only be used on R main thread
+template< int RTYPE >
+class ColumnBuffer {
+
+private:
+
+  typedef typename Rcpp::traits::storage_type< RTYPE >::type Value;
+
+  Rcpp::Vector< RTYPE > data;
+  std::size_t n = 0;
+
+  std::size_t Capacity() const { return data.size(); }
+
+  void Grow( std::size_t capacity ) {
+
+    Rcpp::Vector< RTYPE > grown = Rcpp::no_init( capacity );
+    std::copy( data.begin(), data.begin() + n, grown.begin() );
+    data = grown;
+
+  }
+
+public:
+
+  ColumnBuffer() : data( 0 ) {}
+
+  void Reserve( std::size_t capacity ) { if( capacity > Capacity() ) Grow( capacity ); }
+
+  void Add( Value value ) {
+
+    if( n == Capacity() ) Grow( std::max< std::size_t >( 2 * n, 1024 ) );
+    data[ n++ ] = value;
+
+  }
+
+  std::size_t size() const { return n; }
+
+  // vector returned may already be referenced from R so it is never written again, next Add reallocates
+  Rcpp::Vector< RTYPE > Get() {
+
+    if( n != Capacity() ) data = Rcpp::Vector< RTYPE >( data.begin(), data.begin() + n );
+    return data;
+
+  }
+
+  void Clear() {
+
+    data = Rcpp::Vector< RTYPE >( 0 );
+    n = 0;
+
+  }
+
+  void Serialize( Snapshot& snapshot ) {
+
+    std::vector< Value > values( data.begin(), data.begin() + n );
+    snapshot.Field( values );
+
+    if( not snapshot.IsLoading() ) return;
+
+    Clear();
+    Reserve( values.size() );
+    for( auto value: values ) Add( value );
+
+  }
+
+};
+
+#endif //COLUMNBUFFER_H
@@ -0,0 +1,47 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FENWICKTREE_H
+#define FENWICKTREE_H
+
+#include <vector>
+
+// counts over positions [0,n) with O(log n) update and prefix sum
+class FenwickTree {
+
+private:
+
+  std::vector< int > tree;
+
+public:
+
+  FenwickTree( std::size_t n ) : tree( n + 1, 0 ) {}
+
+  void Add( std::size_t i, int delta ) { for( i++; i < tree.size(); i += i & ( ~i + 1 ) ) tree[i] += delta; }
+
+  // sum over positions [0,i)
+  int Sum( std::size_t i ) const {
+
+    int sum = 0;
+    for( ; i > 0; i -= i & ( ~i + 1 ) ) sum += tree[i];
+    return sum;
+
+  }
+
+};
+
+#endif //FENWICKTREE_H
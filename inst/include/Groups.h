@@ -0,0 +1,96 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GROUPS_H
+#define GROUPS_H
+
+#include <Rcpp.h>
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+#include "Parallel.h"
+
+// groups of rows given by runs of equal consecutive keys, rows of each group must be contiguous
+// e.g. data sorted by symbol, group i is rows [ bounds[i], bounds[i + 1] )
+class Groups {
+
+private:
+
+  std::vector< std::size_t > bounds;
+
+  template< typename Key, typename IsSame >
+  void Split( const Key* keys, std::size_t n, IsSame isSame ) {
+
+    bounds.push_back( 0 );
+    for( std::size_t i = 1; i < n; i++ ) if( not isSame( keys[i - 1], keys[i] ) ) bounds.push_back( i );
+    if( n > 0 ) bounds.push_back( n );
+
+  }
+
+public:
+
+  // integer, factor, logical, numeric or character keys, must be called from main thread
+  Groups( SEXP by ) {
+
+    std::size_t n = XLENGTH( by );
+
+    switch( TYPEOF( by ) ) {
+
+      case INTSXP:
+      case LGLSXP:
+        Split( INTEGER( by ), n, []( int a, int b ) { return a == b; } );
+        break;
+
+      case REALSXP:
+        Split( REAL( by ), n, []( double a, double b ) { return a == b or ( std::isnan( a ) and std::isnan( b ) ); } );
+        break;
+
+      case STRSXP: {
+        // strings are cached by R so equal strings share the same pointer
+        std::vector< SEXP > keys( n );
+        for( std::size_t i = 0; i < n; i++ ) keys[i] = STRING_ELT( by, i );
+        Split( keys.data(), n, []( SEXP a, SEXP b ) { return a == b; } );
+        break;
+      }
+
+      default: throw std::invalid_argument( "by must be integer, factor, logical, numeric or character vector" );
+
+    }
+
+  }
+
+  // number of groups
+  std::size_t size() const { return bounds.size() - 1; }
+
+  // number of rows
+  std::size_t nRows() const { return bounds.back(); }
+
+  std::size_t From( std::size_t i ) const { return bounds[i]; }
+  std::size_t To  ( std::size_t i ) const { return bounds[i + 1]; }
+
+  // calls bulk( x + from, size, out + from ) for every group on nThreads threads ( 0 = all cores )
+  // bulk must not call R API
+  template< typename Bulk >
+  void Apply( const double* x, double* out, int nThreads, Bulk bulk ) const {
+
+    ParallelFor( size(), nThreads, [&]( std::size_t i ) { bulk( x + From( i ), To( i ) - From( i ), out + From( i ) ); } );
+
+  }
+
+};
+
+#endif //GROUPS_H
@@ -19,15 +19,23 @@
 #define INDICATORS_H
 
 #include "Indicators/Sma.h"
+#include "Indicators/SmaBank.h"
+#include "Indicators/SmaTime.h"
 #include "Indicators/Ema.h"
 #include "Indicators/Rsi.h"
 #include "Indicators/Stochastic.h"
 #include "Indicators/RollRange.h"
+#include "Indicators/RollRangeTime.h"
+#include "Indicators/RollMinMax.h"
 #include "Indicators/RollSd.h"
+#include "Indicators/RollSdBank.h"
+#include "Indicators/RollSdTime.h"
 #include "Indicators/RollLinReg.h"
+#include "Indicators/RollLinRegTime.h"
 #include "Indicators/RollPercentRank.h"
 #include "Indicators/RollVolumeProfile.h"
 #include "Indicators/Crossover.h"
 #include "Indicators/BBands.h"
+#include "Indicators/IndicatorGraph.h"
 
 #endif //INDICATORS_H
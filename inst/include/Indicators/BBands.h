@@ -19,6 +19,7 @@
 #define BBANDS_H
 
 #include "Indicator.h"
+#include "History.h"
 #include "Sma.h"
 #include "RollSd.h"
 #include "../ListBuilder.h"
@@ -32,7 +33,7 @@ public:
 
 };
 
-class BBands : public Indicator< double, BBandsValue, Rcpp::List > {
+class BBands : public StaticIndicator< BBands, double, BBandsValue, Rcpp::List > {
 
 private:
 
@@ -41,9 +42,9 @@ private:
   BBandsValue bbands;
   double k;
 
-  std::vector< double > lowerHistory;
-  std::vector< double > upperHistory;
-  std::vector< double > smaHistory;
+  History<> lowerHistory;
+  History<> upperHistory;
+  History<> smaHistory;
 
 public:
 
@@ -51,7 +52,10 @@ public:
   sma( ( size_t )n ),
   sd ( ( size_t )n ),
   k( k )
-  {}
+  {
+    sma.SetHistoryMode( HistoryMode::NONE );
+    sd .SetHistoryMode( HistoryMode::NONE );
+  }
 
   void Add( double value ) {
 
@@ -62,9 +66,9 @@ public:
     bbands.upper = sma.GetValue() + sd.GetValue() * k;
     bbands.sma = sma.GetValue();
 
-    IsFormed() ? lowerHistory.push_back( bbands.lower ) : lowerHistory.push_back( NA_REAL );
-    IsFormed() ? upperHistory.push_back( bbands.upper ) : upperHistory.push_back( NA_REAL );
-    IsFormed() ? smaHistory       .push_back( bbands.sma   ) : smaHistory       .push_back( NA_REAL );
+    IsFormed() ? lowerHistory.Add( bbands.lower ) : lowerHistory.Add( NA_REAL );
+    IsFormed() ? upperHistory.Add( bbands.upper ) : upperHistory.Add( NA_REAL );
+    IsFormed() ? smaHistory       .Add( bbands.sma   ) : smaHistory       .Add( NA_REAL );
 
   }
 
@@ -72,20 +76,58 @@ public:
 
   BBandsValue GetValue() { return bbands; }
 
-  std::vector< double > GetUpperHistory() { return upperHistory; }
-  std::vector< double > GetLowerHistory() { return lowerHistory; }
-  std::vector< double > GetSmaHistory() { return smaHistory; }
+  std::vector< double > GetUpperHistory() { return upperHistory.Get(); }
+  std::vector< double > GetLowerHistory() { return lowerHistory.Get(); }
+  std::vector< double > GetSmaHistory() { return smaHistory.Get(); }
 
   Rcpp::List GetHistory() {
 
     Rcpp::List history = ListBuilder().AsDataTable()
-    .Add( "lower", lowerHistory )
-    .Add( "upper", upperHistory )
-    .Add( "sma"  , smaHistory   );
+    .Add( "lower", lowerHistory.Get() )
+    .Add( "upper", upperHistory.Get() )
+    .Add( "sma"  , smaHistory.Get()   );
     return history;
 
   }
 
+  // values of whole vector x written to lower, upper and sma, does not affect indicator state
+  void Bulk( const double* x, std::size_t size, double* lower, double* upper, double* sma ) const {
+
+    this->sma.Bulk( x, size, sma   );
+    this->sd .Bulk( x, size, upper );
+
+    for( std::size_t i = 0; i < size; i++ ) {
+
+      double sd = upper[i];
+      lower[i] = sma[i] - sd * k;
+      upper[i] = sma[i] + sd * k;
+
+    }
+
+  }
+
+  void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) {
+
+    lowerHistory.SetMode( mode, size );
+    upperHistory.SetMode( mode, size );
+    smaHistory  .SetMode( mode, size );
+
+  }
+
+  void Serialize( Snapshot& snapshot ) {
+
+    snapshot.Check( k );
+    snapshot.Field( bbands.upper );
+    snapshot.Field( bbands.lower );
+    snapshot.Field( bbands.sma   );
+    sma.Serialize( snapshot );
+    sd .Serialize( snapshot );
+    lowerHistory.Serialize( snapshot );
+    upperHistory.Serialize( snapshot );
+    smaHistory  .Serialize( snapshot );
+
+  }
+
   void Reset() {
 
     sma.Reset();
@@ -20,9 +20,10 @@
 
 #include <vector>
 #include "Indicator.h"
+#include "History.h"
 #include <Rcpp.h>
 
-class Crossover : public Indicator< std::pair< double, double >, double, Rcpp::IntegerVector > {
+class Crossover : public StaticIndicator< Crossover, std::pair< double, double >, double, Rcpp::IntegerVector > {
 
 private:
 
@@ -31,7 +32,7 @@ private:
 
   std::pair< double, double > pair;
   Type type;
-  std::vector< int > history;
+  History< int > history;
 
   public:
 
@@ -47,7 +48,7 @@ private:
 
         type = Type::BELOW;
         this->pair = pair;
-        history.push_back( (int)type + 1 );
+        history.Add( (int)type + 1 );
         return;
 
       }
@@ -56,7 +57,7 @@ private:
 
         type = Type::ABOVE;
         this->pair = pair;
-        history.push_back( (int)type + 1 );
+        history.Add( (int)type + 1 );
         return;
 
       }
@@ -67,7 +68,7 @@ private:
       }
 
       type = Type::WAIT;
-      history.push_back( NA_INTEGER );
+      history.Add( NA_INTEGER );
 
     }
 
@@ -75,15 +76,28 @@ private:
 
     bool IsAbove() { return type == Type::ABOVE; }
     bool IsBelow() { return type == Type::BELOW; }
+
+    // factor code of last added value as in history, 1 = UP, 2 = DN, NA if no crossing
+    double GetValue() { return type == Type::WAIT ? NA_REAL : (int)type + 1; }
     Rcpp::IntegerVector GetHistory() {
 
-      Rcpp::IntegerVector history = Rcpp::wrap( this->history );
+      Rcpp::IntegerVector history = Rcpp::wrap( this->history.Get() );
       history.attr( "levels" ) = Rcpp::wrap( TypeString );
       history.attr( "class" ) = "factor";
       return history;
 
     }
 
+    void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) { history.SetMode( mode, size ); }
+
+    void Serialize( Snapshot& snapshot ) {
+
+      snapshot.Field( pair );
+      snapshot.Field( type );
+      history.Serialize( snapshot );
+
+    }
+
     void Reset() {
       pair = { NAN, NAN };
       type = Type::WAIT;
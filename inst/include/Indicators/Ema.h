@@ -20,10 +20,11 @@
 
 #include "Rcpp.h"
 #include "Indicator.h"
+#include "History.h"
 #include <vector>
 #include <stdexcept>
 
-class Ema : public Indicator< double, double, std::vector< double > > {
+class Ema : public StaticIndicator< Ema, double, double, std::vector< double > > {
 
   private:
 
@@ -31,7 +32,7 @@ class Ema : public Indicator< double, double, std::vector< double > > {
     size_t n;
     double ema;
     size_t counter;
-    std::vector< double > history;
+    History<> history;
 
   public:
 
@@ -51,7 +52,7 @@ class Ema : public Indicator< double, double, std::vector< double > > {
 
       if( counter < n ) counter++;
       if( counter == 1 ) ema = value; else ema = value * k + ema * ( 1 - k );
-      IsFormed() ? history.push_back( GetValue() ) : history.push_back( NA_REAL );
+      IsFormed() ? history.Add( GetValue() ) : history.Add( NA_REAL );
 
     }
 
@@ -59,7 +60,35 @@ class Ema : public Indicator< double, double, std::vector< double > > {
 
     double GetValue() { return ema; }
 
-    std::vector<double> GetHistory() { return history; }
+    std::vector<double> GetHistory() { return history.Get(); }
+
+    // values of whole vector x written to out, does not affect indicator state
+    void Bulk( const double* x, std::size_t size, double* out ) const {
+
+      if( size == 0 ) return;
+
+      double ema = x[0];
+      out[0] = n == 1 ? ema : NA_REAL;
+
+      for( std::size_t i = 1; i < size; i++ ) {
+
+        ema = n == 1 ? x[i] : x[i] * k + ema * ( 1 - k );
+        out[i] = i + 1 >= n ? ema : NA_REAL;
+
+      }
+
+    }
+
+    void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) { history.SetMode( mode, size ); }
+
+    void Serialize( Snapshot& snapshot ) {
+
+      snapshot.Check( n );
+      snapshot.Field( ema     );
+      snapshot.Field( counter );
+      history.Serialize( snapshot );
+
+    }
 
     void Reset() {
 
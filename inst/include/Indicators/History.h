@@ -0,0 +1,90 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <vector>
+#include <stdexcept>
+#include "../RingBuffer.h"
+
+// how indicator records its values
+// FULL keeps all values, LAST keeps only last size values, NONE keeps nothing
+enum class HistoryMode { FULL, LAST, NONE };
+
+template< typename T = double >
+class History {
+
+private:
+
+  HistoryMode mode = HistoryMode::FULL;
+  std::vector< T > values;
+  RingBuffer< T > last;
+
+public:
+
+  History() : last( 0 ) {}
+
+  // recorded values are discarded
+  void SetMode( HistoryMode mode, std::size_t size = 0 ) {
+
+    if( mode == HistoryMode::LAST and size == 0 ) throw std::invalid_argument( "history size must be greater than 0" );
+
+    this->mode = mode;
+    std::vector< T >().swap( values );
+    last = RingBuffer< T >( mode == HistoryMode::LAST ? size : 0 );
+
+  }
+
+  HistoryMode GetMode() const { return mode; }
+
+  void Add( const T& value ) {
+
+    switch( mode ) {
+
+      case HistoryMode::FULL: values.push_back( value ); break;
+      case HistoryMode::LAST: last  .PushBack ( value ); break;
+      case HistoryMode::NONE: break;
+
+    }
+
+  }
+
+  // values from oldest to latest
+  std::vector< T > Get() const {
+
+    if( mode != HistoryMode::LAST ) return values;
+
+    std::vector< T > lastValues;
+    lastValues.reserve( last.size() );
+    for( std::size_t i = 0; i < last.size(); i++ ) lastValues.push_back( last[i] );
+    return lastValues;
+
+  }
+
+  void Serialize( Snapshot& snapshot ) {
+
+    // mode and size of last values are set by owner before loading
+    snapshot.Check( mode   );
+    snapshot.Field( values );
+    last.Serialize( snapshot );
+
+  }
+
+};
+
+#endif //HISTORY_H
@@ -1,4 +1,4 @@
-// Copyright (C) 2016 Stanislav Kovalevsky
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
 //
 // This file is part of QuantTools.
 //
@@ -18,6 +18,10 @@
 #ifndef INDICATOR_H
 #define INDICATOR_H
 
+#include <utility>
+#include <type_traits>
+
+// runtime polymorphic indicator interface
 template < typename Input, typename Value, typename History >
 class Indicator {
 
@@ -26,6 +30,78 @@ public:
   virtual void Reset() = 0;
   virtual bool IsFormed() = 0;
   virtual History GetHistory() = 0;
+  virtual ~Indicator() {}
+
+};
+
+// checks that indicator implements static indicator interface, see StaticIndicator
+namespace IndicatorInterface {
+
+  template < typename T, typename = void > struct HasAdd : std::false_type {};
+  template < typename T > struct HasAdd< T, decltype( std::declval< T& >().Add( std::declval< typename T::InputType >() ), void() ) > : std::true_type {};
+
+  template < typename T, typename = void > struct HasReset : std::false_type {};
+  template < typename T > struct HasReset< T, decltype( std::declval< T& >().Reset(), void() ) > : std::true_type {};
+
+  template < typename T, typename = void > struct HasIsFormed : std::false_type {};
+  template < typename T > struct HasIsFormed< T, typename std::enable_if< std::is_convertible< decltype( std::declval< T& >().IsFormed() ), bool >::value >::type > : std::true_type {};
+
+  template < typename T, typename = void > struct HasGetValue : std::false_type {};
+  template < typename T > struct HasGetValue< T, typename std::enable_if< std::is_convertible< decltype( std::declval< T& >().GetValue() ), typename T::ValueType >::value >::type > : std::true_type {};
+
+  template < typename T, typename = void > struct HasGetHistory : std::false_type {};
+  template < typename T > struct HasGetHistory< T, typename std::enable_if< std::is_convertible< decltype( std::declval< T& >().GetHistory() ), typename T::HistoryType >::value >::type > : std::true_type {};
+
+}
+
+// static indicator interface
+// indicators derive from it with their own type as first parameter and implement Add, Reset, IsFormed, GetValue and GetHistory
+// methods are not virtual so calls to indicator and its member indicators are resolved at compile time and can be inlined
+// generic code takes StaticIndicator< Derived, ... >& and calls indicator through Self()
+template < typename Derived, typename Input, typename Value, typename History >
+class StaticIndicator {
+
+public:
+  typedef Input   InputType;
+  typedef Value   ValueType;
+  typedef History HistoryType;
+
+  Derived&       Self()       { return static_cast< Derived&       >( *this ); }
+  const Derived& Self() const { return static_cast< const Derived& >( *this ); }
+
+protected:
+  // instantiated with derived indicator destructor when derived type is complete
+  ~StaticIndicator() {
+
+    static_assert( std::is_base_of< StaticIndicator, Derived >::value      , "indicator must pass its own type as first StaticIndicator parameter" );
+    static_assert( IndicatorInterface::HasAdd       < Derived >::value, "indicator must implement void Add( InputType )" );
+    static_assert( IndicatorInterface::HasReset     < Derived >::value, "indicator must implement void Reset()" );
+    static_assert( IndicatorInterface::HasIsFormed  < Derived >::value, "indicator must implement bool IsFormed()" );
+    static_assert( IndicatorInterface::HasGetValue  < Derived >::value, "indicator must implement ValueType GetValue()" );
+    static_assert( IndicatorInterface::HasGetHistory< Derived >::value, "indicator must implement HistoryType GetHistory()" );
+
+  }
+
+};
+
+// type erased indicator for code which needs runtime polymorphism
+// e.g. std::vector< std::unique_ptr< Indicator< double, double, std::vector< double > > > > holding IndicatorWrapper< Sma > and IndicatorWrapper< Ema >
+template < typename T >
+class IndicatorWrapper : public Indicator< typename T::InputType, typename T::ValueType, typename T::HistoryType > {
+
+private:
+  T indicator;
+
+public:
+  template < typename... Args >
+  IndicatorWrapper( Args&&... args ) : indicator( std::forward< Args >( args )... ) {}
+
+  void Add( typename T::InputType value ) override { indicator.Add( value ); }
+  void Reset() override { indicator.Reset(); }
+  bool IsFormed() override { return indicator.IsFormed(); }
+  typename T::HistoryType GetHistory() override { return indicator.GetHistory(); }
+
+  T& Get() { return indicator; }
 
 };
 
@@ -0,0 +1,400 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef INDICATORGRAPH_H
+#define INDICATORGRAPH_H
+
+#include "Rcpp.h"
+#include "History.h"
+#include "Sma.h"
+#include "Ema.h"
+#include "Rsi.h"
+#include "RollSd.h"
+#include "RollMinMax.h"
+#include "../BackTest/Candle.h"
+#include "../BackTest/Tick.h"
+#include <map>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+// indicators declared against named input streams and evaluated together once per candle or tick
+// nodes are identified by type, inputs and parameters so identical declarations share one node
+// composite indicators are built from shared nodes, e.g. BBands( close, 20, 2 ) uses Sma( close, 20 ) and RollSd( close, 20 )
+// nodes are evaluated by depth so inputs of node are always evaluated before node
+// node is updated only when all its inputs are formed
+class IndicatorGraph {
+
+  public:
+
+    class BBandsNodes {
+    public:
+
+      int lower;
+      int upper;
+      int sma;
+      int sd;
+
+    };
+
+    class StochasticNodes {
+    public:
+
+      int kFast;
+      int dFast;
+      int dSlow;
+
+    };
+
+  private:
+
+    enum class NodeType { INPUT, SMA, EMA, RSI, ROLL_SD, ROLL_MIN, ROLL_MAX, LINEAR, STOCHASTIC };
+
+    class Node {
+    public:
+
+      NodeType type;
+      int inputs[3];      // unused inputs repeat the first one
+      double k;          // LINEAR: value = inputs[0] + inputs[1] * k
+      std::size_t index; // position of indicator in its pool
+      double value;
+      bool isFormed;
+
+    };
+
+    // nodes of the same type and depth evaluated in one loop, steps are ordered by depth
+    class Step {
+    public:
+
+      NodeType type;
+      std::vector< int > nodes;
+
+    };
+
+    // candle and tick stream nodes, -1 if stream is not declared
+    class Streams {
+    public:
+
+      int open   = -1;
+      int high   = -1;
+      int low    = -1;
+      int close  = -1;
+      int volume = -1;
+      int price  = -1;
+      int bid    = -1;
+      int ask    = -1;
+
+    };
+
+    std::vector< Node > nodes;
+    std::vector< Step > steps;
+    std::map< std::string, int > keys;
+    Streams streams;
+
+    std::vector< ::Sma >     smas;
+    std::vector< ::Ema >     emas;
+    std::vector< ::Rsi >     rsis;
+    std::vector< ::RollSd >  sds;
+    std::vector< ::RollMin > mins;
+    std::vector< ::RollMax > maxs;
+
+    template< typename T >
+    static void DisableHistory( T& indicator ) { indicator.SetHistoryMode( HistoryMode::NONE ); }
+    template< typename Compare >
+    static void DisableHistory( RollExtreme< Compare >& ) {}
+
+    static std::string Key( const char* name, const std::vector< int >& inputs, double k ) {
+
+      std::ostringstream key;
+      key.precision( 17 );
+      key << name << '(';
+      for( auto input: inputs ) key << input << ',';
+      key << k << ')';
+      return key.str();
+
+    }
+
+    void Check( int node ) const {
+
+      if( node < 0 or node >= ( int )nodes.size() ) throw std::invalid_argument( "node does not exist" );
+
+    }
+
+    int Insert( const std::string& key, NodeType type, std::vector< int > inputs, double k, std::size_t index ) {
+
+      // input nodes refer to themselves
+      Node node = { type, { 0, 0, 0 }, k, index, NA_REAL, false };
+      for( std::size_t i = 0; i < 3; i++ ) node.inputs[i] = inputs.empty() ? nodes.size() : inputs[ i < inputs.size() ? i : 0 ];
+      nodes.push_back( node );
+      steps.clear();
+      return keys[ key ] = nodes.size() - 1;
+
+    }
+
+    template< typename T >
+    int Stateful( const char* name, NodeType type, int input, int n, std::vector< T >& pool ) {
+
+      std::string key = Key( name, { input }, n );
+      auto it = keys.find( key );
+      if( it != keys.end() ) return it->second;
+
+      Check( input );
+      pool.emplace_back( n );
+      DisableHistory( pool.back() );
+      return Insert( key, type, { input }, n, pool.size() - 1 );
+
+    }
+
+    // depth of node is 0 for inputs and 1 + maximum depth of its inputs otherwise
+    void Compile() {
+
+      std::vector< int > depths( nodes.size(), 0 );
+      std::map< std::pair< int, NodeType >, std::vector< int > > groups;
+
+      for( std::size_t i = 0; i < nodes.size(); i++ ) {
+
+        if( nodes[i].type == NodeType::INPUT ) continue;
+        for( auto input: nodes[i].inputs ) depths[i] = std::max( depths[i], depths[ input ] + 1 );
+        groups[ std::make_pair( depths[i], nodes[i].type ) ].push_back( i );
+
+      }
+
+      steps.clear();
+      for( auto& group: groups ) steps.push_back( { group.first.second, group.second } );
+
+    }
+
+    // unused inputs repeat the first one so all three are checked without branches
+    bool IsReady( const Node& node ) const {
+
+      return nodes[ node.inputs[0] ].isFormed & nodes[ node.inputs[1] ].isFormed & nodes[ node.inputs[2] ].isFormed;
+
+    }
+
+    template< typename T >
+    void Update( const Step& step, std::vector< T >& pool ) {
+
+      for( auto i: step.nodes ) {
+
+        Node& node = nodes[i];
+        T& indicator = pool[ node.index ];
+        if( IsReady( node ) ) indicator.Add( nodes[ node.inputs[0] ].value );
+        node.isFormed = indicator.IsFormed();
+        node.value    = node.isFormed ? indicator.GetValue() : NA_REAL;
+
+      }
+
+    }
+
+    void SetIfExists( int input, double value ) {
+
+      if( input < 0 ) return;
+      nodes[ input ].value    = value;
+      nodes[ input ].isFormed = true;
+
+    }
+
+  public:
+
+    // named input stream, candle streams are 'open', 'high', 'low', 'close', 'volume'
+    // tick streams are 'price', 'volume', 'bid', 'ask'
+    int Input( std::string name ) {
+
+      std::string key = "input:" + name;
+      auto it = keys.find( key );
+      if( it != keys.end() ) return it->second;
+
+      int input = Insert( key, NodeType::INPUT, {}, 0, 0 );
+
+      if( name == "open"   ) streams.open   = input;
+      if( name == "high"   ) streams.high   = input;
+      if( name == "low"    ) streams.low    = input;
+      if( name == "close"  ) streams.close  = input;
+      if( name == "volume" ) streams.volume = input;
+      if( name == "price"  ) streams.price  = input;
+      if( name == "bid"    ) streams.bid    = input;
+      if( name == "ask"    ) streams.ask    = input;
+
+      return input;
+
+    }
+
+    int Sma   ( int input, int n ) { return Stateful( "sma"     , NodeType::SMA     , input, n, smas ); }
+    int Ema   ( int input, int n ) { return Stateful( "ema"     , NodeType::EMA     , input, n, emas ); }
+    int Rsi   ( int input, int n ) { return Stateful( "rsi"     , NodeType::RSI     , input, n, rsis ); }
+    int RollSd( int input, int n ) { return Stateful( "roll_sd" , NodeType::ROLL_SD , input, n, sds  ); }
+    int RollMin( int input, int n ) { return Stateful( "roll_min", NodeType::ROLL_MIN, input, n, mins ); }
+    int RollMax( int input, int n ) { return Stateful( "roll_max", NodeType::ROLL_MAX, input, n, maxs ); }
+
+    // a + b * k
+    int Linear( int a, int b, double k ) {
+
+      std::string key = Key( "linear", { a, b }, k );
+      auto it = keys.find( key );
+      if( it != keys.end() ) return it->second;
+
+      Check( a );
+      Check( b );
+      return Insert( key, NodeType::LINEAR, { a, b }, k, 0 );
+
+    }
+
+    // ( value - low ) / ( high - low ) * 100
+    int StochasticK( int value, int low, int high ) {
+
+      std::string key = Key( "stochastic_k", { value, low, high }, 0 );
+      auto it = keys.find( key );
+      if( it != keys.end() ) return it->second;
+
+      Check( value );
+      Check( low );
+      Check( high );
+      return Insert( key, NodeType::STOCHASTIC, { value, low, high }, 0, 0 );
+
+    }
+
+    // same values as BBands( n, k )
+    BBandsNodes BBands( int input, int n, double k ) {
+
+      int sma = Sma( input, n );
+      int sd  = RollSd( input, n );
+      return { Linear( sma, sd, -k ), Linear( sma, sd, k ), sma, sd };
+
+    }
+
+    // same values as Stochastic< double >( n, nFast, nSlow )
+    StochasticNodes Stochastic( int input, int n, int nFast, int nSlow ) {
+
+      return Stochastic( input, input, input, n, nFast, nSlow );
+
+    }
+
+    // same values as Stochastic< Candle >( n, nFast, nSlow )
+    StochasticNodes Stochastic( int high, int low, int close, int n, int nFast, int nSlow ) {
+
+      int kFast = StochasticK( close, RollMin( low, n ), RollMax( high, n ) );
+      int dFast = Sma( kFast, nFast );
+      return { kFast, dFast, Sma( dFast, nSlow ) };
+
+    }
+
+    void Set( int input, double value ) {
+
+      Check( input );
+      if( nodes[ input ].type != NodeType::INPUT ) throw std::invalid_argument( "node is not input" );
+      nodes[ input ].value    = value;
+      nodes[ input ].isFormed = true;
+
+    }
+
+    // evaluates all nodes once
+    void Update() {
+
+      if( steps.empty() ) Compile();
+
+      for( auto& step: steps ) {
+
+        switch( step.type ) {
+
+          case NodeType::SMA      : Update( step, smas ); break;
+          case NodeType::EMA      : Update( step, emas ); break;
+          case NodeType::RSI      : Update( step, rsis ); break;
+          case NodeType::ROLL_SD  : Update( step, sds  ); break;
+          case NodeType::ROLL_MIN : Update( step, mins ); break;
+          case NodeType::ROLL_MAX : Update( step, maxs ); break;
+
+          case NodeType::LINEAR :
+
+            for( auto i: step.nodes ) {
+
+              Node& node = nodes[i];
+              node.isFormed = IsReady( node );
+              node.value    = node.isFormed ? nodes[ node.inputs[0] ].value + nodes[ node.inputs[1] ].value * node.k : NA_REAL;
+
+            }
+            break;
+
+          case NodeType::STOCHASTIC :
+
+            for( auto i: step.nodes ) {
+
+              Node& node = nodes[i];
+              node.isFormed = IsReady( node );
+              if( not node.isFormed ) { node.value = NA_REAL; continue; }
+              double value = nodes[ node.inputs[0] ].value;
+              double low   = nodes[ node.inputs[1] ].value;
+              double high  = nodes[ node.inputs[2] ].value;
+              node.value = ( value - low ) / ( high - low ) * 100;
+
+            }
+            break;
+
+          case NodeType::INPUT : break;
+
+        }
+
+      }
+
+    }
+
+    // sets candle streams declared in graph and evaluates graph, to be called from Processor::onCandle
+    void Add( const Candle& candle ) {
+
+      SetIfExists( streams.open  , candle.open   );
+      SetIfExists( streams.high  , candle.high   );
+      SetIfExists( streams.low   , candle.low    );
+      SetIfExists( streams.close , candle.close  );
+      SetIfExists( streams.volume, candle.volume );
+      Update();
+
+    }
+
+    // sets tick streams declared in graph and evaluates graph, to be called from Processor::onTick
+    void Add( const Tick& tick ) {
+
+      SetIfExists( streams.price , tick.price  );
+      SetIfExists( streams.volume, tick.volume );
+      SetIfExists( streams.bid   , tick.bid    );
+      SetIfExists( streams.ask   , tick.ask    );
+      Update();
+
+    }
+
+    bool IsFormed( int node ) const { Check( node ); return nodes[ node ].isFormed; }
+
+    // NA if node is not formed
+    double GetValue( int node ) const { Check( node ); return nodes[ node ].value; }
+
+    std::size_t size() const { return nodes.size(); }
+
+    void Reset() {
+
+      for( auto& x: smas ) x.Reset();
+      for( auto& x: emas ) x.Reset();
+      for( auto& x: rsis ) x.Reset();
+      for( auto& x: sds  ) x.Reset();
+      for( auto& x: mins ) x.Reset();
+      for( auto& x: maxs ) x.Reset();
+      for( auto& node: nodes ) { node.value = NA_REAL; node.isFormed = false; }
+
+    }
+
+};
+
+#endif //INDICATORGRAPH_H
@@ -18,8 +18,9 @@
 #ifndef ROLLLINREG_H
 #define ROLLLINREG_H
 
-#include <queue>
+#include "../RingBuffer.h"
 #include "Indicator.h"
+#include "History.h"
 #include "../ListBuilder.h"
 
 class LinRegCoeffs {
@@ -33,7 +34,7 @@ public:
 
 };
 
-class RollLinReg : public Indicator< std::pair< double, double >, double, Rcpp::List > {
+class RollLinReg : public StaticIndicator< RollLinReg, std::pair< double, double >, LinRegCoeffs, Rcpp::List > {
 
 private:
 
@@ -49,17 +50,18 @@ private:
 
   typedef std::pair< double, double > pair;
 
-  std::queue< pair > window;
+  RingBuffer< pair > window;
 
-  std::vector< double > alphaHistory;
-  std::vector< double > betaHistory;
-  std::vector< double > rHistory;
-  std::vector< double > rSquaredHistory;
+  History<> alphaHistory;
+  History<> betaHistory;
+  History<> rHistory;
+  History<> rSquaredHistory;
 
 public:
 
   RollLinReg( int n ) :
-  n( ( size_t )n )
+  n( ( size_t )n ),
+  window( n > 0 ? n : 0 )
   {
     if( n < 1 ) throw std::invalid_argument( "n must be greater than 0" );
 
@@ -74,20 +76,16 @@ public:
 
   void Add( std::pair< double, double > pair ) {
 
-    window.push( pair );
-
     sumX  += pair.first;
     sumXX += pair.first * pair.first;
     sumY  += pair.second;
     sumYY += pair.second * pair.second;
     sumXY += pair.first * pair.second;
 
-    if( window.size() > n ) {
-
-      double oldX = window.front().first;
-      double oldY = window.front().second;
+    if( window.IsFull() ) {
 
-      window.pop();
+      double oldX = window.Front().first;
+      double oldY = window.Front().second;
 
       sumX  -= oldX;
       sumXX -= oldX * oldX;
@@ -96,6 +94,7 @@ public:
       sumXY -= oldX * oldY;
 
     }
+    window.PushBack( pair );
 
     if( window.size() == n ) {
 
@@ -112,17 +111,17 @@ public:
 
     if( IsFormed() ) {
 
-      alphaHistory   .push_back( coeffs.alpha    );
-      betaHistory    .push_back( coeffs.beta     );
-      rHistory       .push_back( coeffs.r        );
-      rSquaredHistory.push_back( coeffs.rSquared );
+      alphaHistory   .Add( coeffs.alpha    );
+      betaHistory    .Add( coeffs.beta     );
+      rHistory       .Add( coeffs.r        );
+      rSquaredHistory.Add( coeffs.rSquared );
 
     } else {
 
-      alphaHistory   .push_back( NA_REAL );
-      betaHistory    .push_back( NA_REAL );
-      rHistory       .push_back( NA_REAL );
-      rSquaredHistory.push_back( NA_REAL );
+      alphaHistory   .Add( NA_REAL );
+      betaHistory    .Add( NA_REAL );
+      rHistory       .Add( NA_REAL );
+      rSquaredHistory.Add( NA_REAL );
 
     }
 
@@ -132,6 +131,92 @@ public:
 
   bool IsFormed() { return window.size() == n; }
 
+  // values of whole vectors x and y written to outputs, does not affect indicator state
+  // outputs which are not needed can be nullptr
+  void Bulk( const double* x, const double* y, std::size_t size, double* alpha, double* beta, double* r, double* rSquared ) const {
+
+    double sumX  = 0;
+    double sumXX = 0;
+    double sumY  = 0;
+    double sumYY = 0;
+    double sumXY = 0;
+
+    LinRegCoeffs coeffs = {};
+
+    for( std::size_t i = 0; i < size; i++ ) {
+
+      sumX  += x[i];
+      sumXX += x[i] * x[i];
+      sumY  += y[i];
+      sumYY += y[i] * y[i];
+      sumXY += x[i] * y[i];
+
+      if( i >= n ) {
+
+        double oldX = x[i - n];
+        double oldY = y[i - n];
+
+        sumX  -= oldX;
+        sumXX -= oldX * oldX;
+        sumY  -= oldY;
+        sumYY -= oldY * oldY;
+        sumXY -= oldX * oldY;
+
+      }
+
+      bool isFormed = i + 1 >= n;
+
+      if( isFormed ) {
+
+        double covXY = n * sumXY - sumX * sumY;
+        double varX  = n * sumXX - sumX * sumX;
+        double varY  = n * sumYY - sumY * sumY;
+
+        coeffs.beta     = covXY / varX;
+        coeffs.alpha    = ( sumY - coeffs.beta  * sumX ) / n;
+        coeffs.r        = covXY / std::sqrt( varX * varY );
+        coeffs.rSquared = coeffs.r * coeffs.r;
+
+      }
+
+      if( alpha    != nullptr ) alpha   [i] = isFormed ? coeffs.alpha    : NA_REAL;
+      if( beta     != nullptr ) beta    [i] = isFormed ? coeffs.beta     : NA_REAL;
+      if( r        != nullptr ) r       [i] = isFormed ? coeffs.r        : NA_REAL;
+      if( rSquared != nullptr ) rSquared[i] = isFormed ? coeffs.rSquared : NA_REAL;
+
+    }
+
+  }
+
+  void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) {
+
+    alphaHistory   .SetMode( mode, size );
+    betaHistory    .SetMode( mode, size );
+    rHistory       .SetMode( mode, size );
+    rSquaredHistory.SetMode( mode, size );
+
+  }
+
+  void Serialize( Snapshot& snapshot ) {
+
+    snapshot.Check( n );
+    snapshot.Field( sumX  );
+    snapshot.Field( sumXX );
+    snapshot.Field( sumY  );
+    snapshot.Field( sumYY );
+    snapshot.Field( sumXY );
+    snapshot.Field( coeffs.alpha    );
+    snapshot.Field( coeffs.beta     );
+    snapshot.Field( coeffs.r        );
+    snapshot.Field( coeffs.rSquared );
+    window.Serialize( snapshot );
+    alphaHistory   .Serialize( snapshot );
+    betaHistory    .Serialize( snapshot );
+    rHistory       .Serialize( snapshot );
+    rSquaredHistory.Serialize( snapshot );
+
+  }
+
   void Reset() {
 
     sumX  = 0;
@@ -141,27 +226,26 @@ public:
     sumXY = 0;
     coeffs = {};
 
-    std::queue< pair > empty;
-    std::swap( window, empty );
+    window.clear();
 
   }
 
   Rcpp::List GetHistory() {
 
     Rcpp::List history = ListBuilder().AsDataTable()
-    .Add( "alpha"    , alphaHistory    )
-    .Add( "beta"     , betaHistory     )
-    .Add( "r"        , rHistory        )
-    .Add( "r.squared", rSquaredHistory );
+    .Add( "alpha"    , alphaHistory.Get()    )
+    .Add( "beta"     , betaHistory.Get()     )
+    .Add( "r"        , rHistory.Get()        )
+    .Add( "r.squared", rSquaredHistory.Get() );
     return history;
 
     return history;
   }
 
-  std::vector< double > GetAlphaHistory()    { return alphaHistory   ; }
-  std::vector< double > GetBetaHistory()     { return betaHistory    ; }
-  std::vector< double > GetRHistory()        { return rHistory       ; }
-  std::vector< double > GetRSquaredHistory() { return rSquaredHistory; }
+  std::vector< double > GetAlphaHistory()    { return alphaHistory.Get()   ; }
+  std::vector< double > GetBetaHistory()     { return betaHistory.Get()    ; }
+  std::vector< double > GetRHistory()        { return rHistory.Get()       ; }
+  std::vector< double > GetRSquaredHistory() { return rSquaredHistory.Get(); }
 
 };
 
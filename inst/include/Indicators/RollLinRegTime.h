@@ -0,0 +1,143 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+#ifndef ROLLLINREGTIME_H
+#define ROLLLINREGTIME_H
+
+#include "RollLinReg.h"
+#include "TimeWindow.h"
+#include "Indicator.h"
+#include "History.h"
+#include "../ListBuilder.h"
+#include <cmath>
+
+// rolling linear regression of ( x, y ) pairs of last seconds
+class RollLinRegTime : public StaticIndicator< RollLinRegTime, Timed< std::pair< double, double > >, LinRegCoeffs, Rcpp::List > {
+
+private:
+
+  double sumX  = 0;
+  double sumXX = 0;
+  double sumY  = 0;
+  double sumYY = 0;
+  double sumXY = 0;
+
+  LinRegCoeffs coeffs = {};
+
+  typedef std::pair< double, double > pair;
+
+  TimeWindow< pair > window;
+
+  History<> alphaHistory;
+  History<> betaHistory;
+  History<> rHistory;
+  History<> rSquaredHistory;
+
+public:
+
+  RollLinRegTime( double seconds ) : window( seconds ) {}
+
+  void Add( Timed< pair > value ) {
+
+    window.Check( value.time );
+
+    const pair& xy = value.value;
+
+    sumX  += xy.first;
+    sumXX += xy.first * xy.first;
+    sumY  += xy.second;
+    sumYY += xy.second * xy.second;
+    sumXY += xy.first * xy.second;
+
+    window.Add( value, [this]( const pair& old ) {
+
+      sumX  -= old.first;
+      sumXX -= old.first * old.first;
+      sumY  -= old.second;
+      sumYY -= old.second * old.second;
+      sumXY -= old.first * old.second;
+
+    } );
+
+    if( IsFormed() ) {
+
+      double n = window.size();
+
+      double covXY = n * sumXY - sumX * sumY;
+      double varX  = n * sumXX - sumX * sumX;
+      double varY  = n * sumYY - sumY * sumY;
+
+      coeffs.beta     = covXY / varX;
+      coeffs.alpha    = ( sumY - coeffs.beta  * sumX ) / n;
+      coeffs.r        = covXY / std::sqrt( varX * varY );
+      coeffs.rSquared = coeffs.r * coeffs.r;
+
+    }
+
+    alphaHistory   .Add( IsFormed() ? coeffs.alpha    : NA_REAL );
+    betaHistory    .Add( IsFormed() ? coeffs.beta     : NA_REAL );
+    rHistory       .Add( IsFormed() ? coeffs.r        : NA_REAL );
+    rSquaredHistory.Add( IsFormed() ? coeffs.rSquared : NA_REAL );
+
+  }
+
+  void Add( double time, pair xy ) { Add( Timed< pair >{ time, xy } ); }
+
+  LinRegCoeffs GetValue() { return coeffs; }
+
+  bool IsFormed() { return window.IsFormed(); }
+
+  void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) {
+
+    alphaHistory   .SetMode( mode, size );
+    betaHistory    .SetMode( mode, size );
+    rHistory       .SetMode( mode, size );
+    rSquaredHistory.SetMode( mode, size );
+
+  }
+
+  void Reset() {
+
+    sumX  = 0;
+    sumXX = 0;
+    sumY  = 0;
+    sumYY = 0;
+    sumXY = 0;
+    coeffs = {};
+
+    window.clear();
+
+  }
+
+  Rcpp::List GetHistory() {
+
+    Rcpp::List history = ListBuilder().AsDataTable()
+    .Add( "alpha"    , alphaHistory.Get()    )
+    .Add( "beta"     , betaHistory.Get()     )
+    .Add( "r"        , rHistory.Get()        )
+    .Add( "r.squared", rSquaredHistory.Get() );
+    return history;
+
+  }
+
+  std::vector< double > GetAlphaHistory()    { return alphaHistory.Get()   ; }
+  std::vector< double > GetBetaHistory()     { return betaHistory.Get()    ; }
+  std::vector< double > GetRHistory()        { return rHistory.Get()       ; }
+  std::vector< double > GetRSquaredHistory() { return rSquaredHistory.Get(); }
+
+};
+
+#endif //ROLLLINREGTIME_H
@@ -0,0 +1,121 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROLLMINMAX_H
+#define ROLLMINMAX_H
+
+#include <utility>
+#include <functional>
+#include <stdexcept>
+#include "../RingBuffer.h"
+#include "TimeWindow.h"
+
+// rolling minimum or maximum over n last values in O(1) amortized time
+// only values which may still become extreme are kept so buffer values are monotonic
+template< typename Compare >
+class RollExtreme {
+
+private:
+
+  std::size_t n;
+  std::size_t nAdded = 0;
+  RingBuffer< std::pair< std::size_t, double > > candidates; // value number and value
+  Compare isBetter;
+
+public:
+
+  RollExtreme( int n ) :
+  n( ( std::size_t )n ),
+  candidates( n > 0 ? n : 0 )
+  {
+    if( n < 1 ) throw std::invalid_argument( "n must be greater than 0" );
+  }
+
+  void Add( double value ) {
+
+    if( not candidates.empty() and candidates.Front().first + n <= nAdded ) candidates.PopFront();
+
+    while( not candidates.empty() and not isBetter( candidates.Back().second, value ) ) candidates.PopBack();
+
+    candidates.PushBack( std::make_pair( nAdded++, value ) );
+
+  }
+
+  bool IsFormed() { return nAdded >= n; }
+
+  double GetValue() { return candidates.Front().second; }
+
+  void Serialize( Snapshot& snapshot ) {
+
+    snapshot.Check( n );
+    snapshot.Field( nAdded );
+    candidates.Serialize( snapshot );
+
+  }
+
+  void Reset() {
+
+    nAdded = 0;
+    candidates.clear();
+
+  }
+
+};
+
+typedef RollExtreme< std::less   < double > > RollMin;
+typedef RollExtreme< std::greater< double > > RollMax;
+
+// rolling minimum or maximum over values of last seconds in O(1) amortized time
+template< typename Compare >
+class RollExtremeTime {
+
+private:
+
+  double seconds;
+  RingBuffer< Timed< double > > candidates;
+  Compare isBetter;
+
+public:
+
+  RollExtremeTime( double seconds ) :
+  seconds( seconds ),
+  candidates( 16 )
+  {
+    if( not ( seconds > 0 ) ) throw std::invalid_argument( "seconds must be greater than 0" );
+  }
+
+  void Add( Timed< double > value ) {
+
+    while( not candidates.empty() and candidates.Front().time <= value.time - seconds ) candidates.PopFront();
+
+    while( not candidates.empty() and not isBetter( candidates.Back().value, value.value ) ) candidates.PopBack();
+
+    if( candidates.IsFull() ) candidates.Reserve( 2 * candidates.capacity() );
+    candidates.PushBack( value );
+
+  }
+
+  double GetValue() { return candidates.Front().value; }
+
+  void Reset() { candidates.clear(); }
+
+};
+
+typedef RollExtremeTime< std::less   < double > > RollMinTime;
+typedef RollExtremeTime< std::greater< double > > RollMaxTime;
+
+#endif //ROLLMINMAX_H
@@ -20,47 +20,75 @@
 
 #include <math.h>
 #include <vector>
-#include <queue>
-#include <set>
+#include <algorithm>
 #include "Indicator.h"
+#include "History.h"
+#include "../OrderStatisticTree.h"
+#include "../FenwickTree.h"
+#include "../RingBuffer.h"
 #include "Rcpp.h"
 
-class RollPercentRank : public Indicator< double, double, std::vector< double > > {
+// percent rank is share of window values strictly less than current value
+// NaN values are not ranked and have zero rank
+class RollPercentRank : public StaticIndicator< RollPercentRank, double, double, std::vector< double > > {
 
 private:
 
   size_t n;
-  std::queue<double> window;
-  std::multiset<double> windowSorted;
+  RingBuffer< double > window;
+  OrderStatisticTree windowSorted;
   double percentRank;
 
-  std::vector< double > history;
+  History<> history;
+
+  // bulk workspace kept between calls
+  std::vector< double > levels;
+  std::vector< size_t > ids;
 
 public:
 
   RollPercentRank( int n ) :
-  n( ( size_t )n )
+  n( ( size_t )n ),
+  window( n > 0 ? n : 0 )
   {
     if( n < 1 ) throw std::invalid_argument( "n must be greater than 0" );
   }
 
   void Add( double value ) {
 
-    window.push( value );
-    windowSorted.insert( value );
+    if( window.IsFull() and not std::isnan( window.Front() ) ) windowSorted.Erase( window.Front() );
 
-    if( window.size() > n ) {
+    window.PushBack( value );
+    if( not std::isnan( value ) ) windowSorted.Insert( value );
+    percentRank = std::isnan( value ) ? 0 : windowSorted.CountLess( value ) * 1. / n;
+    // bug max value not equal 1;
 
-      windowSorted.erase( windowSorted.find( window.front() ) );
-      window.pop();
+    IsFormed() ? history.Add( GetValue() ) : history.Add( NA_REAL );
 
-    }
-    auto it = std::lower_bound( windowSorted.begin(), windowSorted.end(), value );
-    int distance = std::distance( windowSorted.begin(), it );
-    percentRank = distance * 1. / n;
-    // bug max value not equal 1;
+  }
+
+  // values of whole vector x written to out, does not affect indicator state
+  // values are mapped to ranks of sorted unique values and window is counted by fenwick tree
+  void Bulk( const double* x, size_t size, double* out ) {
+
+    levels.assign( x, x + size );
+    levels.erase( std::remove_if( levels.begin(), levels.end(), []( double value ) { return std::isnan( value ); } ), levels.end() );
+    std::sort( levels.begin(), levels.end() );
+    levels.erase( std::unique( levels.begin(), levels.end() ), levels.end() );
+
+    ids.resize( size );
+    for( size_t i = 0; i < size; i++ ) ids[i] = std::isnan( x[i] ) ? levels.size() : std::lower_bound( levels.begin(), levels.end(), x[i] ) - levels.begin();
+
+    FenwickTree counts( levels.size() + 1 );
+
+    for( size_t i = 0; i < size; i++ ) {
+
+      counts.Add( ids[i], 1 );
+      if( i >= n ) counts.Add( ids[i - n], -1 );
 
-    IsFormed() ? history.push_back( GetValue() ) : history.push_back( NA_REAL );
+      out[i] = i + 1 < n ? NA_REAL : ids[i] == levels.size() ? 0 : counts.Sum( ids[i] ) * 1. / n;
+
+    }
 
   }
 
@@ -68,12 +96,30 @@ public:
 
   double GetValue() { return percentRank; }
 
-  std::vector< double > GetHistory() { return history; }
+  std::vector< double > GetHistory() { return history.Get(); }
+
+  void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) { history.SetMode( mode, size ); }
+
+  // sorted window is rebuilt from window on load
+  void Serialize( Snapshot& snapshot ) {
+
+    snapshot.Check( n );
+    snapshot.Field( percentRank );
+    window .Serialize( snapshot );
+    history.Serialize( snapshot );
+
+    if( snapshot.IsLoading() ) {
+
+      windowSorted.clear();
+      for( size_t i = 0; i < window.size(); i++ ) if( not std::isnan( window[i] ) ) windowSorted.Insert( window[i] );
+
+    }
+
+  }
 
   void Reset() {
 
-    std::queue< double > empty;
-    std::swap( window, empty );
+    window.clear();
     windowSorted.clear();
 
   }
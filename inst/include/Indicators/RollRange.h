@@ -21,10 +21,12 @@
 #include <Rcpp.h>
 
 #include "Indicator.h"
+#include "History.h"
+#include "RollMinMax.h"
+#include "../OrderStatisticTree.h"
+#include "../RingBuffer.h"
 #include <math.h>
 #include <vector>
-#include <queue>
-#include <set>
 #include "../ListBuilder.h"
 
 class Range {
@@ -37,76 +39,130 @@ public:
 
 };
 
-class RollRange : public Indicator< double, double, Rcpp::List > {
+class RollRange : public StaticIndicator< RollRange, double, Range, Rcpp::List > {
 
 private:
 
   Range range;
   size_t n;
   double p;
-  std::queue< double > window;
-  std::multiset< double > windowSorted;
+  RollMin rollMin;
+  RollMax rollMax;
 
-  std::vector< double > minHistory;
-  std::vector< double > maxHistory;
-  std::vector< double > quantileHistory;
+  // window is sorted only if quantile is neither min nor max
+  size_t nFromEnd;
+  bool isQuantile;
+  RingBuffer< double > window;
+  OrderStatisticTree windowSorted;
+
+  History<> minHistory;
+  History<> maxHistory;
+  History<> quantileHistory;
 
 public:
 
   RollRange( int n, double p = 1 ) :
   n( ( size_t )n ),
-  p( p )
+  p( p ),
+  rollMin( n ),
+  rollMax( n ),
+  window( 0 )
   {
     if( n < 1 ) throw std::invalid_argument( "n must be greater than 0" );
     if( p < 0 or p > 1 ) throw std::invalid_argument( "p must be in [0,1]" );
+
+    nFromEnd   = static_cast< size_t >( std::trunc( ( p >= 0.5 ? 1. - p : p ) * n ) );
+    isQuantile = nFromEnd > 0;
+    if( isQuantile ) window = RingBuffer< double >( n );
   }
 
   void Add( double value ) {
 
-    window.push( value );
-    windowSorted.insert( value );
+    rollMin.Add( value );
+    rollMax.Add( value );
 
-    if( window.size() > n ) {
+    range.min = rollMin.GetValue();
+    range.max = rollMax.GetValue();
 
-      windowSorted.erase( windowSorted.find( window.front() ) );
-      window.pop();
+    if( isQuantile ) {
 
-    }
-    range.min = *windowSorted.begin();
-    range.max = *std::prev( windowSorted.end() );
-    if( IsFormed() ) range.quantile = p >= 0.5 ?
-    *std::next( windowSorted.rbegin() , static_cast< int >( std::trunc( ( 1. - p ) * n ) ) ) :
-    *std::next( windowSorted.begin() , static_cast< int >( std::trunc( p * n ) ) );
+      if( window.IsFull() and not std::isnan( window.Front() ) ) windowSorted.Erase( window.Front() );
+
+      window.PushBack( value );
+      if( not std::isnan( value ) ) windowSorted.Insert( value );
+
+      if( IsFormed() ) {
+
+        size_t size = windowSorted.size();
+        range.quantile = size <= nFromEnd ? NA_REAL : windowSorted.Select( p >= 0.5 ? size - 1 - nFromEnd : nFromEnd );
+
+      }
+
+    } else if( IsFormed() ) range.quantile = p >= 0.5 ? range.max : range.min;
 
     //Rcpp::Rcout << range.min << " " << range.max << " " << range.quantile << std::endl;
 
-    IsFormed() ? minHistory.push_back( range.min ) : minHistory.push_back( NA_REAL );
-    IsFormed() ? maxHistory.push_back( range.max ) : maxHistory.push_back( NA_REAL );
-    IsFormed() ? quantileHistory.push_back( range.quantile ) : quantileHistory.push_back( NA_REAL );
+    IsFormed() ? minHistory.Add( range.min ) : minHistory.Add( NA_REAL );
+    IsFormed() ? maxHistory.Add( range.max ) : maxHistory.Add( NA_REAL );
+    IsFormed() ? quantileHistory.Add( range.quantile ) : quantileHistory.Add( NA_REAL );
 
   }
 
-  bool IsFormed() { return window.size() == n; }
+  bool IsFormed() { return rollMax.IsFormed(); }
 
   Range GetValue() { return range; }
 
-  std::vector< double > GetMinHistory()      { return minHistory     ; }
-  std::vector< double > GetMaxHistory()      { return maxHistory     ; }
-  std::vector< double > GetQuantileHistory() { return quantileHistory; }
+  std::vector< double > GetMinHistory()      { return minHistory.Get();      }
+  std::vector< double > GetMaxHistory()      { return maxHistory.Get();      }
+  std::vector< double > GetQuantileHistory() { return quantileHistory.Get(); }
 
   Rcpp::List GetHistory() {
 
     Rcpp::List history = ListBuilder().AsDataTable()
-    .Add( "min", minHistory )
-    .Add( "max", maxHistory );
+    .Add( "min", minHistory.Get() )
+    .Add( "max", maxHistory.Get() );
     return history;
 
   }
 
+  void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) {
+
+    minHistory     .SetMode( mode, size );
+    maxHistory     .SetMode( mode, size );
+    quantileHistory.SetMode( mode, size );
+
+  }
+
+  // sorted window is rebuilt from window on load
+  void Serialize( Snapshot& snapshot ) {
+
+    snapshot.Check( n );
+    snapshot.Check( p );
+    snapshot.Field( range.min      );
+    snapshot.Field( range.max      );
+    snapshot.Field( range.quantile );
+    rollMin.Serialize( snapshot );
+    rollMax.Serialize( snapshot );
+    window .Serialize( snapshot );
+    minHistory     .Serialize( snapshot );
+    maxHistory     .Serialize( snapshot );
+    quantileHistory.Serialize( snapshot );
+
+    if( snapshot.IsLoading() ) {
+
+      windowSorted.clear();
+      for( std::size_t i = 0; i < window.size(); i++ ) if( not std::isnan( window[i] ) ) windowSorted.Insert( window[i] );
+
+    }
+
+  }
+
   void Reset() {
 
-    std::queue< double > empty;
-    std::swap( window, empty );
+    rollMin.Reset();
+    rollMax.Reset();
+
+    window.clear();
     windowSorted.clear();
 
   }
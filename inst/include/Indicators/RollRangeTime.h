@@ -0,0 +1,138 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+#ifndef ROLLRANGETIME_H
+#define ROLLRANGETIME_H
+
+#include <Rcpp.h>
+#include "Indicator.h"
+#include "History.h"
+#include "RollRange.h"
+#include "RollMinMax.h"
+#include "TimeWindow.h"
+#include "../OrderStatisticTree.h"
+#include "../ListBuilder.h"
+#include <cmath>
+
+// rolling minimum, maximum and quantile of values of last seconds
+// quantile is taken from the same position as in RollRange of window size equal to number of values in window
+class RollRangeTime : public StaticIndicator< RollRangeTime, Timed< double >, Range, Rcpp::List > {
+
+private:
+
+  Range range;
+  double p;
+  RollMinTime rollMin;
+  RollMaxTime rollMax;
+
+  // window is sorted only if quantile is neither min nor max
+  bool isQuantile;
+  TimeWindow< double > window;
+  OrderStatisticTree windowSorted;
+
+  History<> minHistory;
+  History<> maxHistory;
+  History<> quantileHistory;
+
+public:
+
+  RollRangeTime( double seconds, double p = 1 ) :
+  p( p ),
+  rollMin( seconds ),
+  rollMax( seconds ),
+  window( seconds )
+  {
+    if( p < 0 or p > 1 ) throw std::invalid_argument( "p must be in [0,1]" );
+
+    isQuantile = p > 0 and p < 1;
+  }
+
+  void Add( Timed< double > value ) {
+
+    window.Check( value.time );
+
+    rollMin.Add( value );
+    rollMax.Add( value );
+
+    range.min = rollMin.GetValue();
+    range.max = rollMax.GetValue();
+
+    if( isQuantile ) {
+
+      window.Add( value, [this]( double old ) { if( not std::isnan( old ) ) windowSorted.Erase( old ); } );
+      if( not std::isnan( value.value ) ) windowSorted.Insert( value.value );
+
+      if( IsFormed() ) {
+
+        size_t nFromEnd = static_cast< size_t >( std::trunc( ( p >= 0.5 ? 1. - p : p ) * window.size() ) );
+        size_t size = windowSorted.size();
+        range.quantile = size <= nFromEnd ? NA_REAL : windowSorted.Select( p >= 0.5 ? size - 1 - nFromEnd : nFromEnd );
+
+      }
+
+    } else {
+
+      window.Add( value, []( double ) {} );
+      if( IsFormed() ) range.quantile = p >= 0.5 ? range.max : range.min;
+
+    }
+
+    IsFormed() ? minHistory.Add( range.min ) : minHistory.Add( NA_REAL );
+    IsFormed() ? maxHistory.Add( range.max ) : maxHistory.Add( NA_REAL );
+    IsFormed() ? quantileHistory.Add( range.quantile ) : quantileHistory.Add( NA_REAL );
+
+  }
+
+  void Add( double time, double value ) { Add( Timed< double >{ time, value } ); }
+
+  bool IsFormed() { return window.IsFormed(); }
+
+  Range GetValue() { return range; }
+
+  std::vector< double > GetMinHistory()      { return minHistory.Get();      }
+  std::vector< double > GetMaxHistory()      { return maxHistory.Get();      }
+  std::vector< double > GetQuantileHistory() { return quantileHistory.Get(); }
+
+  Rcpp::List GetHistory() {
+
+    Rcpp::List history = ListBuilder().AsDataTable()
+    .Add( "min", minHistory.Get() )
+    .Add( "max", maxHistory.Get() );
+    return history;
+
+  }
+
+  void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) {
+
+    minHistory     .SetMode( mode, size );
+    maxHistory     .SetMode( mode, size );
+    quantileHistory.SetMode( mode, size );
+
+  }
+
+  void Reset() {
+
+    rollMin.Reset();
+    rollMax.Reset();
+
+    window.clear();
+    windowSorted.clear();
+
+  }
+
+};
+
+#endif //ROLLRANGETIME_H
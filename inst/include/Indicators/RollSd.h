@@ -18,14 +18,15 @@
 #ifndef ROLLSD_H
 #define ROLLSD_H
 
-#include <queue>
 #include <vector>
 #include <stdexcept>
 #include <cmath>
 #include "Rcpp.h"
 #include "Indicator.h"
+#include "History.h"
+#include "../RingBuffer.h"
 
-class RollSd : public Indicator< double, double, std::vector<double> > {
+class RollSd : public StaticIndicator< RollSd, double, double, std::vector<double> > {
 
 private:
 
@@ -36,14 +37,15 @@ private:
 
   std::size_t n;
 
-  std::queue< double > window;
+  RingBuffer< double > window;
 
-  std::vector< double > history;
+  History<> history;
 
 public:
 
   RollSd( int n ) :
-  n( ( std::size_t )n )
+  n( ( std::size_t )n ),
+  window( n > 0 ? n : 0 )
   {
     if( n < 2 ) throw std::invalid_argument( "n must be greater than 1" );
     sumX = 0;
@@ -54,21 +56,19 @@ public:
 
     sumX += value;
     sumXX += value * value;
-    window.push( value );
 
-    if( window.size() > n ) {
+    if( window.IsFull() ) {
 
-      double old = window.front();
-
-      window.pop();
+      double old = window.Front();
 
       sumX -= old;
       sumXX -= old * old;
 
     }
+    window.PushBack( value );
     sd = std::sqrt( sumXX / n - ( sumX / n ) * ( sumX / n ) ) * std::sqrt( n * 1. / ( n - 1 ) );
 
-    IsFormed() ? history.push_back( GetValue() ) : history.push_back( NA_REAL );
+    IsFormed() ? history.Add( GetValue() ) : history.Add( NA_REAL );
 
   }
 
@@ -76,12 +76,50 @@ public:
 
   double GetValue() { return sd; }
 
-  std::vector<double> GetHistory() { return history; }
+  std::vector<double> GetHistory() { return history.Get(); }
+
+  // values of whole vector x written to out, does not affect indicator state
+  void Bulk( const double* x, std::size_t size, double* out ) const {
+
+    double sumX  = 0;
+    double sumXX = 0;
+    double scale = std::sqrt( n * 1. / ( n - 1 ) );
+
+    for( std::size_t i = 0; i < size; i++ ) {
+
+      sumX  += x[i];
+      sumXX += x[i] * x[i];
+
+      if( i >= n ) {
+
+        double old = x[i - n];
+
+        sumX  -= old;
+        sumXX -= old * old;
+
+      }
+      out[i] = i + 1 >= n ? std::sqrt( sumXX / n - ( sumX / n ) * ( sumX / n ) ) * scale : NA_REAL;
+
+    }
+
+  }
+
+  void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) { history.SetMode( mode, size ); }
+
+  void Serialize( Snapshot& snapshot ) {
+
+    snapshot.Check( n );
+    snapshot.Field( sumX  );
+    snapshot.Field( sumXX );
+    snapshot.Field( sd    );
+    window .Serialize( snapshot );
+    history.Serialize( snapshot );
+
+  }
 
   void Reset() {
 
-    std::queue<double> empty;
-    std::swap( window, empty );
+    window.clear();
     sumX = 0;
     sumXX = 0;
 
@@ -0,0 +1,171 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ROLLSDBANK_H
+#define ROLLSDBANK_H
+
+#include "Rcpp.h"
+#include "Indicator.h"
+#include "History.h"
+#include "../RingBuffer.h"
+#include "../ListBuilder.h"
+#include <cmath>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+// rolling standard deviations of several window sizes updated in one pass over shared window
+// each deviation is calculated exactly as RollSd of the same window size
+class RollSdBank : public StaticIndicator< RollSdBank, double, std::vector< double >, Rcpp::List > {
+
+private:
+
+  std::vector< std::size_t > n;
+  std::vector< double > sumX;
+  std::vector< double > sumXX;
+  std::vector< double > values;
+  RingBuffer< double > window;
+  std::vector< History<> > histories;
+
+  double Sd( std::size_t i ) const {
+
+    return std::sqrt( sumXX[i] / n[i] - ( sumX[i] / n[i] ) * ( sumX[i] / n[i] ) ) * std::sqrt( n[i] * 1. / ( n[i] - 1 ) );
+
+  }
+
+public:
+
+  RollSdBank( std::vector< int > n ) :
+  window( n.empty() ? 0 : std::max( *std::max_element( n.begin(), n.end() ), 0 ) )
+  {
+    if( n.empty() ) throw std::invalid_argument( "n must not be empty" );
+    for( auto x: n ) if( x < 2 ) throw std::invalid_argument( "n must be greater than 1" );
+
+    this->n.assign( n.begin(), n.end() );
+    sumX     .assign( n.size(), 0 );
+    sumXX    .assign( n.size(), 0 );
+    values   .assign( n.size(), NA_REAL );
+    histories.resize( n.size() );
+  }
+
+  void Add( double value ) {
+
+    for( std::size_t i = 0; i < n.size(); i++ ) {
+
+      sumX [i] += value;
+      sumXX[i] += value * value;
+
+      if( window.size() >= n[i] ) {
+
+        double old = window[ window.size() - n[i] ];
+
+        sumX [i] -= old;
+        sumXX[i] -= old * old;
+
+      }
+      values[i] = Sd( i );
+
+    }
+    window.PushBack( value );
+
+    for( std::size_t i = 0; i < n.size(); i++ ) IsFormed( i ) ? histories[i].Add( values[i] ) : histories[i].Add( NA_REAL );
+
+  }
+
+  // all deviations are formed
+  bool IsFormed() { return window.IsFull(); }
+
+  bool IsFormed( std::size_t i ) { return window.size() >= n[i]; }
+
+  const std::vector< double >& GetValue() { return values; }
+
+  double GetValue( std::size_t i ) { return values[i]; }
+
+  std::vector< std::size_t > GetN() { return n; }
+
+  // data.table with column sd_<n> for each window size
+  Rcpp::List GetHistory() {
+
+    ListBuilder history;
+    history.AsDataTable();
+    for( std::size_t i = 0; i < n.size(); i++ ) history.Add( "sd_" + std::to_string( n[i] ), histories[i].Get() );
+    return history;
+
+  }
+
+  std::vector< double > GetHistory( std::size_t i ) { return histories[i].Get(); }
+
+  // values of whole vector x written to out[i] for each window size, does not affect indicator state
+  // x is processed by blocks and all window sizes are updated over block while it is in cache
+  void Bulk( const double* x, std::size_t size, const std::vector< double* >& out ) const {
+
+    const std::size_t blockSize = 4096;
+    std::vector< double > sumX ( n.size(), 0 );
+    std::vector< double > sumXX( n.size(), 0 );
+
+    for( std::size_t from = 0; from < size; from += blockSize ) {
+
+      std::size_t to = std::min( from + blockSize, size );
+
+      for( std::size_t i = 0; i < n.size(); i++ ) {
+
+        double sX    = sumX [i];
+        double sXX   = sumXX[i];
+        std::size_t n = this->n[i];
+        double scale = std::sqrt( n * 1. / ( n - 1 ) );
+        double* values = out[i];
+
+        for( std::size_t j = from; j < to; j++ ) {
+
+          sX  += x[j];
+          sXX += x[j] * x[j];
+
+          if( j >= n ) {
+
+            double old = x[j - n];
+
+            sX  -= old;
+            sXX -= old * old;
+
+          }
+          values[j] = j + 1 >= n ? std::sqrt( sXX / n - ( sX / n ) * ( sX / n ) ) * scale : NA_REAL;
+
+        }
+        sumX [i] = sX;
+        sumXX[i] = sXX;
+
+      }
+
+    }
+
+  }
+
+  void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) { for( auto& history: histories ) history.SetMode( mode, size ); }
+
+  void Reset() {
+
+    window.clear();
+    std::fill( sumX  .begin(), sumX  .end(), 0 );
+    std::fill( sumXX .begin(), sumXX .end(), 0 );
+    std::fill( values.begin(), values.end(), NA_REAL );
+
+  }
+
+};
+
+#endif //ROLLSDBANK_H
@@ -0,0 +1,114 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+#ifndef ROLLSDTIME_H
+#define ROLLSDTIME_H
+
+#include "Rcpp.h"
+#include "Indicator.h"
+#include "History.h"
+#include "TimeWindow.h"
+#include <cmath>
+#include <stdexcept>
+
+// rolling standard deviation of values of last seconds, NA if window has less than 2 values
+class RollSdTime : public StaticIndicator< RollSdTime, Timed< double >, double, std::vector< double > > {
+
+private:
+
+  double sumX  = 0;
+  double sumXX = 0;
+  double sd    = NA_REAL;
+  TimeWindow< double > window;
+  History<> history;
+
+  static double Sd( double sumX, double sumXX, std::size_t n ) {
+
+    return n < 2 ? NA_REAL : std::sqrt( sumXX / n - ( sumX / n ) * ( sumX / n ) ) * std::sqrt( n * 1. / ( n - 1 ) );
+
+  }
+
+public:
+
+  RollSdTime( double seconds ) : window( seconds ) {}
+
+  void Add( Timed< double > value ) {
+
+    window.Check( value.time );
+
+    sumX  += value.value;
+    sumXX += value.value * value.value;
+
+    window.Add( value, [this]( double old ) { sumX -= old; sumXX -= old * old; } );
+
+    sd = Sd( sumX, sumXX, window.size() );
+
+    IsFormed() ? history.Add( GetValue() ) : history.Add( NA_REAL );
+
+  }
+
+  void Add( double time, double value ) { Add( Timed< double >{ time, value } ); }
+
+  bool IsFormed() { return window.IsFormed(); }
+
+  double GetValue() { return sd; }
+
+  std::vector<double> GetHistory() { return history.Get(); }
+
+  // values of whole vector x with times time written to out, does not affect indicator state
+  void Bulk( const double* time, const double* x, std::size_t size, double* out ) const {
+
+    double seconds = window.GetSeconds();
+    double sumX  = 0;
+    double sumXX = 0;
+    std::size_t from = 0;
+
+    for( std::size_t i = 0; i < size; i++ ) {
+
+      if( std::isnan( time[i] ) ) throw std::invalid_argument( "time must not be NA" );
+      if( std::isinf( time[i] ) ) throw std::invalid_argument( "time must be finite" );
+      if( i > 0 and time[i] < time[i - 1] ) throw std::invalid_argument( "time must not decrease" );
+
+      sumX  += x[i];
+      sumXX += x[i] * x[i];
+
+      for( ; from < i and time[from] <= time[i] - seconds; from++ ) {
+
+        sumX  -= x[from];
+        sumXX -= x[from] * x[from];
+
+      }
+
+      out[i] = time[i] - time[0] >= seconds ? Sd( sumX, sumXX, i + 1 - from ) : NA_REAL;
+
+    }
+
+  }
+
+  void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) { history.SetMode( mode, size ); }
+
+  void Reset() {
+
+    sumX  = 0;
+    sumXX = 0;
+    sd    = NA_REAL;
+    window.clear();
+
+  }
+
+};
+
+#endif //ROLLSDTIME_H
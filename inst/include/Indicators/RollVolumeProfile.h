@@ -19,14 +19,14 @@
 #define ROLLVOLUMEPROFILE_H
 
 #include <math.h>
-#include <queue>
 #include <set>
 #include "../BackTest/Tick.h"
 #include "../ListBuilder.h"
 #include "../CppToR.h"
 #include "Indicator.h"
+#include "History.h"
 
-class RollVolumeProfile : public Indicator< Tick, std::map<double,double>, Rcpp::List > {
+class RollVolumeProfile : public StaticIndicator< RollVolumeProfile, Tick, std::map<double,double>, Rcpp::List > {
 
 private:
 
@@ -37,8 +37,8 @@ private:
   std::map<double,double> histogram;
   double time;
 
-  std::vector< double > timeHistory;
-  std::vector<Rcpp::List> volumeProfileHistory;
+  History<> timeHistory;
+  History< Rcpp::List > volumeProfileHistory;
 
 public:
 
@@ -92,8 +92,8 @@ public:
         .Add( "price" , prices  )
         .Add( "volume", volumes );
 
-      volumeProfileHistory.push_back( volumeProfile );
-      timeHistory.push_back( time );
+      volumeProfileHistory.Add( volumeProfile );
+      timeHistory.Add( time );
 
       this->time = time;
     }
@@ -110,12 +110,19 @@ public:
   Rcpp::List GetHistory(){
 
     Rcpp::List history = ListBuilder()
-    .Add( "time"   , DoubleToDateTime( timeHistory, "UTC" ) )
-    .Add( "profile", volumeProfileHistory                   );
+    .Add( "time"   , DoubleToDateTime( timeHistory.Get(), "UTC" ) )
+    .Add( "profile", volumeProfileHistory.Get()             );
     return history;
 
   }
 
+  void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) {
+
+    timeHistory         .SetMode( mode, size );
+    volumeProfileHistory.SetMode( mode, size );
+
+  }
+
   void Reset() {
 
     histogram.clear();
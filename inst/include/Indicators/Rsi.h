@@ -21,16 +21,16 @@
 #define RSI_H
 
 #include "Indicator.h"
+#include "History.h"
 #include "Sma.h"
-#include <queue>
 
-class Rsi : public Indicator< double, double, std::vector<double> > {
+class Rsi : public StaticIndicator< Rsi, double, double, std::vector<double> > {
 
   private:
 
     //Sma avgGain;
     //Sma avgLoss;
-    std::vector< double > history;
+    History<> history;
 
     double avgGain;
     double avgLoss;
@@ -82,7 +82,7 @@ class Rsi : public Indicator< double, double, std::vector<double> > {
       }
       //Rcpp::Rcout << " avgGain " << avgGain << " avgLoss " << avgLoss << " currGain " << currGain << " currLoss " << currLoss << std::endl;
 
-      IsFormed() ? history.push_back( GetValue() ) : history.push_back( NA_REAL );
+      IsFormed() ? history.Add( GetValue() ) : history.Add( NA_REAL );
 
 
     }
@@ -96,7 +96,64 @@ class Rsi : public Indicator< double, double, std::vector<double> > {
 
     }
 
-    std::vector<double> GetHistory() { return history; }
+    std::vector<double> GetHistory() { return history.Get(); }
+
+    // values of whole vector x written to out, does not affect indicator state
+    void Bulk( const double* x, std::size_t size, double* out ) const {
+
+      double avgGain   = 0;
+      double avgLoss   = 0;
+      double prevValue = NAN;
+      int    counter   = 0;
+
+      for( std::size_t i = 0; i < size; i++ ) {
+
+        counter++;
+
+        if( std::isnan( prevValue ) ) prevValue = x[i];
+        double change = x[i] - prevValue;
+        prevValue = x[i];
+
+        double currGain = change > 0 ?  change : 0;
+        double currLoss = change < 0 ? -change : 0;
+
+        if( counter > n ) {
+
+          avgGain = ( avgGain * ( n - 1 ) + currGain ) / n;
+          avgLoss = ( avgLoss * ( n - 1 ) + currLoss ) / n;
+
+        } else {
+
+          avgGain += currGain;
+          avgLoss += currLoss;
+
+          if( counter == n ) {
+
+            avgGain = avgGain / n;
+            avgLoss = avgLoss / n;
+
+          }
+
+        }
+
+        out[i] = counter > n ? ( avgGain > 0 ? 100. - 100. / ( 1 + avgGain / avgLoss ) : 100. ) : NA_REAL;
+
+      }
+
+    }
+
+    void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) { history.SetMode( mode, size ); }
+
+    void Serialize( Snapshot& snapshot ) {
+
+      snapshot.Check( n );
+      snapshot.Field( avgGain   );
+      snapshot.Field( avgLoss   );
+      snapshot.Field( counter   );
+      snapshot.Field( prevValue );
+      history.Serialize( snapshot );
+
+    }
 
     void Reset() {
 
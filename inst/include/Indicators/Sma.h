@@ -20,22 +20,24 @@
 
 #include "Rcpp.h"
 #include "Indicator.h"
-#include <queue>
+#include "History.h"
+#include "../RingBuffer.h"
 #include <stdexcept>
 
-class Sma : public Indicator< double, double, std::vector<double> > {
+class Sma : public StaticIndicator< Sma, double, double, std::vector<double> > {
 
   private:
 
     double sum;
     std::size_t n;
-    std::queue< double > window;
-    std::vector< double > history;
+    RingBuffer< double > window;
+    History<> history;
 
   public:
 
     Sma( int n ) :
-    n( ( std::size_t )n )
+    n( ( std::size_t )n ),
+    window( n > 0 ? n : 0 )
     {
       if( n < 1 ) throw std::invalid_argument( "n must be greater than 0" );
       sum = 0;
@@ -45,16 +47,12 @@ class Sma : public Indicator< double, double, std::vector<double> > {
     {
 
       sum += value;
-      window.push( value );
 
-      if( window.size() > n ) {
+      if( window.IsFull() ) sum -= window.Front();
 
-        sum -= window.front();
-        window.pop();
+      window.PushBack( value );
 
-      }
-
-      IsFormed() ? history.push_back( GetValue() ) : history.push_back( NA_REAL );
+      IsFormed() ? history.Add( GetValue() ) : history.Add( NA_REAL );
 
 
     }
@@ -63,12 +61,40 @@ class Sma : public Indicator< double, double, std::vector<double> > {
 
     double GetValue() { return sum / n; }
 
-    std::vector<double> GetHistory() { return history; }
+    std::vector<double> GetHistory() { return history.Get(); }
+
+    // values of whole vector x written to out, does not affect indicator state
+    void Bulk( const double* x, std::size_t size, double* out ) const {
+
+      double sum = 0;
+      std::size_t i = 0;
+
+      for( ; i < size and i + 1 < n; i++ ) { sum += x[i]; out[i] = NA_REAL; }
+      for( ; i < size and i < n; i++ ) { sum += x[i]; out[i] = sum / n; }
+      for( ; i < size; i++ ) {
+
+        sum += x[i];
+        sum -= x[i - n];
+        out[i] = sum / n;
+
+      }
+
+    }
+
+    void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) { history.SetMode( mode, size ); }
+
+    void Serialize( Snapshot& snapshot ) {
+
+      snapshot.Check( n );
+      snapshot.Field( sum );
+      window .Serialize( snapshot );
+      history.Serialize( snapshot );
+
+    }
 
     void Reset() {
       sum = 0;
-      std::queue< double > empty;
-      std::swap( window, empty );
+      window.clear();
 
     }
 
@@ -0,0 +1,138 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SMABANK_H
+#define SMABANK_H
+
+#include "Rcpp.h"
+#include "Indicator.h"
+#include "History.h"
+#include "../RingBuffer.h"
+#include "../ListBuilder.h"
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+// simple moving averages of several window sizes updated in one pass over shared window
+// each average is calculated exactly as Sma of the same window size
+class SmaBank : public StaticIndicator< SmaBank, double, std::vector< double >, Rcpp::List > {
+
+  private:
+
+    std::vector< std::size_t > n;
+    std::vector< double > sums;
+    std::vector< double > values;
+    RingBuffer< double > window;
+    std::vector< History<> > histories;
+
+  public:
+
+    SmaBank( std::vector< int > n ) :
+    window( n.empty() ? 0 : std::max( *std::max_element( n.begin(), n.end() ), 0 ) )
+    {
+      if( n.empty() ) throw std::invalid_argument( "n must not be empty" );
+      for( auto x: n ) if( x < 1 ) throw std::invalid_argument( "n must be greater than 0" );
+
+      this->n.assign( n.begin(), n.end() );
+      sums     .assign( n.size(), 0 );
+      values   .assign( n.size(), NA_REAL );
+      histories.resize( n.size() );
+    }
+
+    void Add( double value )
+    {
+
+      for( std::size_t i = 0; i < n.size(); i++ ) {
+
+        sums[i] += value;
+        if( window.size() >= n[i] ) sums[i] -= window[ window.size() - n[i] ];
+        values[i] = sums[i] / n[i];
+
+      }
+      window.PushBack( value );
+
+      for( std::size_t i = 0; i < n.size(); i++ ) IsFormed( i ) ? histories[i].Add( values[i] ) : histories[i].Add( NA_REAL );
+
+    }
+
+    // all averages are formed
+    bool IsFormed() { return window.IsFull(); }
+
+    bool IsFormed( std::size_t i ) { return window.size() >= n[i]; }
+
+    const std::vector< double >& GetValue() { return values; }
+
+    double GetValue( std::size_t i ) { return values[i]; }
+
+    std::vector< std::size_t > GetN() { return n; }
+
+    // data.table with column sma_<n> for each window size
+    Rcpp::List GetHistory() {
+
+      ListBuilder history;
+      history.AsDataTable();
+      for( std::size_t i = 0; i < n.size(); i++ ) history.Add( "sma_" + std::to_string( n[i] ), histories[i].Get() );
+      return history;
+
+    }
+
+    std::vector< double > GetHistory( std::size_t i ) { return histories[i].Get(); }
+
+    // values of whole vector x written to out[i] for each window size, does not affect indicator state
+    // x is processed by blocks and all window sizes are updated over block while it is in cache
+    void Bulk( const double* x, std::size_t size, const std::vector< double* >& out ) const {
+
+      const std::size_t blockSize = 4096;
+      std::vector< double > sums( n.size(), 0 );
+
+      for( std::size_t from = 0; from < size; from += blockSize ) {
+
+        std::size_t to = std::min( from + blockSize, size );
+
+        for( std::size_t i = 0; i < n.size(); i++ ) {
+
+          double sum = sums[i];
+          std::size_t n = this->n[i];
+          double* values = out[i];
+
+          for( std::size_t j = from; j < to; j++ ) {
+
+            sum += x[j];
+            if( j >= n ) sum -= x[j - n];
+            values[j] = j + 1 >= n ? sum / n : NA_REAL;
+
+          }
+          sums[i] = sum;
+
+        }
+
+      }
+
+    }
+
+    void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) { for( auto& history: histories ) history.SetMode( mode, size ); }
+
+    void Reset() {
+      std::fill( sums.begin(), sums.end(), 0 );
+      std::fill( values.begin(), values.end(), NA_REAL );
+      window.clear();
+    }
+
+};
+
+#endif //SMABANK_H
@@ -0,0 +1,93 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+#ifndef SMATIME_H
+#define SMATIME_H
+
+#include "Rcpp.h"
+#include "Indicator.h"
+#include "History.h"
+#include "TimeWindow.h"
+#include <stdexcept>
+
+// simple moving average of values of last seconds
+class SmaTime : public StaticIndicator< SmaTime, Timed< double >, double, std::vector< double > > {
+
+  private:
+
+    double sum = 0;
+    TimeWindow< double > window;
+    History<> history;
+
+  public:
+
+    SmaTime( double seconds ) : window( seconds ) {}
+
+    void Add( Timed< double > value )
+    {
+
+      window.Check( value.time );
+
+      sum += value.value;
+
+      window.Add( value, [this]( double old ) { sum -= old; } );
+
+      IsFormed() ? history.Add( GetValue() ) : history.Add( NA_REAL );
+
+    }
+
+    void Add( double time, double value ) { Add( Timed< double >{ time, value } ); }
+
+    bool IsFormed() { return window.IsFormed(); }
+
+    double GetValue() { return sum / window.size(); }
+
+    std::vector<double> GetHistory() { return history.Get(); }
+
+    // values of whole vector x with times time written to out, does not affect indicator state
+    void Bulk( const double* time, const double* x, std::size_t size, double* out ) const {
+
+      double seconds = window.GetSeconds();
+      double sum = 0;
+      std::size_t from = 0;
+
+      for( std::size_t i = 0; i < size; i++ ) {
+
+        if( std::isnan( time[i] ) ) throw std::invalid_argument( "time must not be NA" );
+        if( std::isinf( time[i] ) ) throw std::invalid_argument( "time must be finite" );
+        if( i > 0 and time[i] < time[i - 1] ) throw std::invalid_argument( "time must not decrease" );
+
+        sum += x[i];
+        for( ; from < i and time[from] <= time[i] - seconds; from++ ) sum -= x[from];
+
+        out[i] = time[i] - time[0] >= seconds ? sum / ( i + 1 - from ) : NA_REAL;
+
+      }
+
+    }
+
+    void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) { history.SetMode( mode, size ); }
+
+    void Reset() {
+
+      sum = 0;
+      window.clear();
+
+    }
+
+};
+
+#endif //SMATIME_H
@@ -19,11 +19,11 @@
 #define STOCHASTIC_H
 
 #include "Indicator.h"
+#include "History.h"
 #include "Sma.h"
-#include "RollRange.h"
+#include "RollMinMax.h"
 #include "../BackTest/Candle.h"
 #include "../ListBuilder.h"
-#include <queue>
 
 
 class StochasticValue {
@@ -37,19 +37,19 @@ public:
 };
 
 template< typename Input >
-class Stochastic : public Indicator< Input, StochasticValue, Rcpp::List > {
+class Stochastic : public StaticIndicator< Stochastic< Input >, Input, StochasticValue, Rcpp::List > {
 
   private:
 
-    RollRange high;
-    RollRange low;
+    RollMax high;
+    RollMin low;
     Sma dFast;
     Sma dSlow;
     StochasticValue info;
 
-    std::vector< double > kFastHistory;
-    std::vector< double > dFastHistory;
-    std::vector< double > dSlowHistory;
+    History<> kFastHistory;
+    History<> dFastHistory;
+    History<> dSlowHistory;
 
     void Update( Candle candle ) {
 
@@ -58,7 +58,7 @@ class Stochastic : public Indicator< Input, StochasticValue, Rcpp::List > {
 
       if( high.IsFormed() and low.IsFormed() ) {
 
-        info.kFast = ( candle.close - low.GetValue().min ) / ( high.GetValue().max - low.GetValue().min ) * 100;
+        info.kFast = ( candle.close - low.GetValue() ) / ( high.GetValue() - low.GetValue() ) * 100;
         dFast.Add( info.kFast );
         if( dFast.IsFormed() ) dSlow.Add( dFast.GetValue() );
         info.dFast = dFast.GetValue();
@@ -75,7 +75,7 @@ class Stochastic : public Indicator< Input, StochasticValue, Rcpp::List > {
 
       if( high.IsFormed() and low.IsFormed() ) {
 
-        info.kFast = ( value - low.GetValue().min ) / ( high.GetValue().max - low.GetValue().min ) * 100;
+        info.kFast = ( value - low.GetValue() ) / ( high.GetValue() - low.GetValue() ) * 100;
         dFast.Add( info.kFast );
         if( dFast.IsFormed() ) dSlow.Add( dFast.GetValue() );
         info.dFast = dFast.GetValue();
@@ -88,11 +88,14 @@ class Stochastic : public Indicator< Input, StochasticValue, Rcpp::List > {
   public:
 
     Stochastic( int n, int nFast, int nSlow ) :
-    high( ( size_t )n ),
-    low( ( size_t )n ),
+    high( n ),
+    low( n ),
     dFast( ( size_t )nFast ),
     dSlow( ( size_t )nSlow )
-    {}
+    {
+      dFast.SetHistoryMode( HistoryMode::NONE );
+      dSlow.SetHistoryMode( HistoryMode::NONE );
+    }
 
     void Add( Input value )
     {
@@ -101,9 +104,9 @@ class Stochastic : public Indicator< Input, StochasticValue, Rcpp::List > {
 
       Update( value );
 
-      IsFormed() ? kFastHistory.push_back( info.kFast ) : kFastHistory.push_back( NA_REAL );
-      IsFormed() ? dFastHistory.push_back( info.dFast ) : dFastHistory.push_back( NA_REAL );
-      IsFormed() ? dSlowHistory.push_back( info.dSlow ) : dSlowHistory.push_back( NA_REAL );
+      IsFormed() ? kFastHistory.Add( info.kFast ) : kFastHistory.Add( NA_REAL );
+      IsFormed() ? dFastHistory.Add( info.dFast ) : dFastHistory.Add( NA_REAL );
+      IsFormed() ? dSlowHistory.Add( info.dSlow ) : dSlowHistory.Add( NA_REAL );
 
     }
 
@@ -114,16 +117,39 @@ class Stochastic : public Indicator< Input, StochasticValue, Rcpp::List > {
     Rcpp::List GetHistory() {
 
       Rcpp::List history = ListBuilder().AsDataTable()
-      .Add( "k_fast", kFastHistory )
-      .Add( "d_fast", dFastHistory )
-      .Add( "d_slow", dSlowHistory );
+      .Add( "k_fast", kFastHistory.Get() )
+      .Add( "d_fast", dFastHistory.Get() )
+      .Add( "d_slow", dSlowHistory.Get() );
       return history;
 
     }
 
-    std::vector< double > GetKFastHistory() { return kFastHistory; }
-    std::vector< double > GetDFastHistory() { return dFastHistory; }
-    std::vector< double > GetDSlowHistory() { return dSlowHistory; }
+    std::vector< double > GetKFastHistory() { return kFastHistory.Get(); }
+    std::vector< double > GetDFastHistory() { return dFastHistory.Get(); }
+    std::vector< double > GetDSlowHistory() { return dSlowHistory.Get(); }
+
+    void SetHistoryMode( HistoryMode mode, std::size_t size = 0 ) {
+
+      kFastHistory.SetMode( mode, size );
+      dFastHistory.SetMode( mode, size );
+      dSlowHistory.SetMode( mode, size );
+
+    }
+
+    void Serialize( Snapshot& snapshot ) {
+
+      snapshot.Field( info.kFast );
+      snapshot.Field( info.dFast );
+      snapshot.Field( info.dSlow );
+      high .Serialize( snapshot );
+      low  .Serialize( snapshot );
+      dFast.Serialize( snapshot );
+      dSlow.Serialize( snapshot );
+      kFastHistory.Serialize( snapshot );
+      dFastHistory.Serialize( snapshot );
+      dSlowHistory.Serialize( snapshot );
+
+    }
 
     void Reset() {
 
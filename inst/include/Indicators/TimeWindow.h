@@ -0,0 +1,107 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+#ifndef TIMEWINDOW_H
+#define TIMEWINDOW_H
+
+#include "../RingBuffer.h"
+#include <cmath>
+#include <stdexcept>
+
+// value with its time, input of time window indicators
+template< typename T >
+class Timed {
+
+public:
+
+  double time;
+  T value;
+
+};
+
+// values of last seconds, value is removed once it is seconds old or older
+// buffer grows when full so after warm-up values are added without allocation
+template< typename T >
+class TimeWindow {
+
+private:
+
+  double seconds;
+  double timeFirst = NAN;
+  double timeLast  = NAN;
+  RingBuffer< Timed< T > > items;
+
+public:
+
+  TimeWindow( double seconds ) :
+  seconds( seconds ),
+  items( 16 )
+  {
+    if( not ( seconds > 0 ) ) throw std::invalid_argument( "seconds must be greater than 0" );
+  }
+
+  // throws if item of given time can not be added, indicators call it before they update their state
+  void Check( double time ) const {
+
+    if( std::isnan( time ) ) throw std::invalid_argument( "time must not be NA" );
+    if( std::isinf( time ) ) throw std::invalid_argument( "time must be finite" );
+    if( time < timeLast ) throw std::invalid_argument( "time must not decrease" );
+
+  }
+
+  // adds item and calls onExpired( value ) for every removed value, oldest first
+  template< typename OnExpired >
+  void Add( const Timed< T >& item, OnExpired onExpired ) {
+
+    Check( item.time );
+
+    if( items.IsFull() ) items.Reserve( 2 * items.capacity() );
+    items.PushBack( item );
+
+    // item just added is never removed even if seconds are below time precision
+    while( items.size() > 1 and items.Front().time <= item.time - seconds ) {
+
+      onExpired( items.Front().value );
+      items.PopFront();
+
+    }
+
+    if( std::isnan( timeFirst ) ) timeFirst = item.time;
+    timeLast = item.time;
+
+  }
+
+  // window is formed once values of at least seconds were added
+  bool IsFormed() const { return timeLast - timeFirst >= seconds; }
+
+  double GetSeconds() const { return seconds; }
+
+  std::size_t size() const { return items.size(); }
+
+  const Timed< T >& Front() const { return items.Front(); }
+  const Timed< T >& Back()  const { return items.Back();  }
+
+  void clear() {
+
+    items.clear();
+    timeFirst = NAN;
+    timeLast  = NAN;
+
+  }
+
+};
+
+#endif //TIMEWINDOW_H
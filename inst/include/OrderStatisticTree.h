@@ -0,0 +1,211 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ORDERSTATISTICTREE_H
+#define ORDERSTATISTICTREE_H
+
+#include <vector>
+#include <cstdint>
+
+// multiset of numbers which counts values less than given one and finds k-th smallest value in O(log n) expected time
+// randomized binary search tree ( treap ) with subtree sizes, nodes are stored in vector and reused
+// so no allocation happens once tree has reached its maximum size
+class OrderStatisticTree {
+
+private:
+
+  struct Node {
+
+    double   value;
+    uint32_t priority;
+    int      size;
+    int      left;
+    int      right;
+
+  };
+
+  std::vector< Node > nodes;
+  std::vector< int  > freeNodes;
+  int      root = -1;
+  uint32_t seed = 2463534242;
+
+  uint32_t Random() {
+
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+
+  }
+
+  int Size( int t ) const { return t < 0 ? 0 : nodes[t].size; }
+
+  void Update( int t ) { nodes[t].size = 1 + Size( nodes[t].left ) + Size( nodes[t].right ); }
+
+  // splits tree into values less than value and the rest
+  void Split( int t, double value, int& less, int& rest ) {
+
+    if( t < 0 ) { less = -1; rest = -1; return; }
+
+    if( nodes[t].value < value ) {
+
+      Split( nodes[t].right, value, nodes[t].right, rest );
+      less = t;
+
+    } else {
+
+      Split( nodes[t].left, value, less, nodes[t].left );
+      rest = t;
+
+    }
+
+    Update( t );
+
+  }
+
+  // all values of l must not be greater than values of r
+  int Merge( int l, int r ) {
+
+    if( l < 0 ) return r;
+    if( r < 0 ) return l;
+
+    if( nodes[l].priority > nodes[r].priority ) {
+
+      int right = Merge( nodes[l].right, r );
+      nodes[l].right = right;
+      Update( l );
+      return l;
+
+    }
+
+    int left = Merge( l, nodes[r].left );
+    nodes[r].left = left;
+    Update( r );
+    return r;
+
+  }
+
+  int Erase( int t, double value ) {
+
+    if( t < 0 ) return t;
+
+    if( nodes[t].value == value ) {
+
+      freeNodes.push_back( t );
+      return Merge( nodes[t].left, nodes[t].right );
+
+    }
+
+    if( value < nodes[t].value ) {
+
+      int left = Erase( nodes[t].left, value );
+      nodes[t].left = left;
+
+    } else {
+
+      int right = Erase( nodes[t].right, value );
+      nodes[t].right = right;
+
+    }
+
+    Update( t );
+    return t;
+
+  }
+
+public:
+
+  void Insert( double value ) {
+
+    int t;
+
+    if( freeNodes.empty() ) {
+
+      t = nodes.size();
+      nodes.push_back( Node() );
+
+    } else {
+
+      t = freeNodes.back();
+      freeNodes.pop_back();
+
+    }
+
+    nodes[t] = { value, Random(), 1, -1, -1 };
+
+    int less, rest;
+    Split( root, value, less, rest );
+    root = Merge( Merge( less, t ), rest );
+
+  }
+
+  // removes one value equal to given one if any
+  void Erase( double value ) { root = Erase( root, value ); }
+
+  // number of values less than value
+  int CountLess( double value ) const {
+
+    int count = 0;
+
+    for( int t = root; t >= 0; ) {
+
+      if( nodes[t].value < value ) {
+
+        count += Size( nodes[t].left ) + 1;
+        t = nodes[t].right;
+
+      } else t = nodes[t].left;
+
+    }
+
+    return count;
+
+  }
+
+  // k-th smallest value counting from 0, k must be less than size
+  double Select( int k ) const {
+
+    for( int t = root; ; ) {
+
+      int nLeft = Size( nodes[t].left );
+
+      if( k == nLeft ) return nodes[t].value;
+
+      if( k < nLeft ) t = nodes[t].left; else {
+
+        k -= nLeft + 1;
+        t = nodes[t].right;
+
+      }
+
+    }
+
+  }
+
+  int size() const { return Size( root ); }
+
+  void clear() {
+
+    nodes.clear();
+    freeNodes.clear();
+    root = -1;
+
+  }
+
+};
+
+#endif //ORDERSTATISTICTREE_H
@@ -0,0 +1,83 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <exception>
+#include <functional>
+
+inline int NThreads( int nThreads ) {
+
+  if( nThreads <= 0 ) nThreads = std::thread::hardware_concurrency();
+  return nThreads <= 0 ? 1 : nThreads;
+
+}
+
+// calls task( i ) for every i in [0,n) on nThreads threads ( 0 = all cores )
+// tasks are picked dynamically so long and short tasks are balanced
+// task must not call R API, first exception thrown is rethrown in calling thread
+inline void ParallelFor( std::size_t n, int nThreads, std::function< void( std::size_t ) > task ) {
+
+  nThreads = NThreads( nThreads );
+  if( ( std::size_t )nThreads > n ) nThreads = n;
+
+  if( nThreads <= 1 ) {
+
+    for( std::size_t i = 0; i < n; i++ ) task( i );
+    return;
+
+  }
+
+  std::atomic< std::size_t > next( 0 );
+  std::exception_ptr error = nullptr;
+  std::mutex errorMutex;
+
+  auto worker = [&]() {
+
+    for( std::size_t i = next++; i < n; i = next++ ) {
+
+      try {
+
+        task( i );
+
+      } catch( ... ) {
+
+        std::lock_guard< std::mutex > lock( errorMutex );
+        if( error == nullptr ) error = std::current_exception();
+        next = n;
+
+      }
+
+    }
+
+  };
+
+  std::vector< std::thread > threads;
+  for( int i = 1; i < nThreads; i++ ) threads.push_back( std::thread( worker ) );
+  worker();
+  for( auto& thread: threads ) thread.join();
+
+  if( error != nullptr ) std::rethrow_exception( error );
+
+}
+
+#endif //PARALLEL_H
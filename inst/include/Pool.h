@@ -0,0 +1,145 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <new>
+#include <functional>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+// chunked object pool
+// objects never move so pointers stay valid, freed slots are reused before new chunks are allocated
+// Clear destroys all alive objects at once and keeps chunks for reuse
+template< class T >
+class Pool {
+
+private:
+
+  struct Slot {
+
+    typename std::aligned_storage< sizeof( T ), alignof( T ) >::type data; // must be first member
+    bool isAlive;
+
+  };
+
+  std::size_t chunkSize;
+  std::size_t nSlots = 0; // slots taken from chunks
+  std::vector< Slot* > chunks;
+  std::vector< Slot* > freeSlots;
+
+  Slot* Take() {
+
+    if( not freeSlots.empty() ) {
+
+      Slot* slot = freeSlots.back();
+      freeSlots.pop_back();
+      return slot;
+
+    }
+
+    if( nSlots == chunks.size() * chunkSize ) chunks.push_back( new Slot[ chunkSize ] );
+
+    Slot* slot = chunks[ nSlots / chunkSize ] + nSlots % chunkSize;
+    nSlots++;
+    return slot;
+
+  }
+
+public:
+
+  Pool( std::size_t chunkSize = 1024 ) : chunkSize( chunkSize ) {}
+
+  Pool( const Pool& ) = delete;
+  Pool& operator=( const Pool& ) = delete;
+
+  ~Pool() {
+
+    Clear();
+    for( auto chunk: chunks ) delete[] chunk;
+
+  }
+
+  template< class... Args >
+  T* New( Args&&... args ) {
+
+    Slot* slot = Take();
+    slot->isAlive = false;
+
+    T* object;
+    try {
+
+      object = new( &slot->data ) T( std::forward< Args >( args )... );
+
+    } catch( ... ) {
+
+      freeSlots.push_back( slot );
+      throw;
+
+    }
+    slot->isAlive = true;
+
+    return object;
+
+  }
+
+  void Delete( T* object ) {
+
+    Slot* slot = reinterpret_cast< Slot* >( object );
+
+    object->~T();
+    slot->isAlive = false;
+    freeSlots.push_back( slot );
+
+  }
+
+  void Clear() {
+
+    if( not std::is_trivially_destructible< T >::value ) {
+
+      for( std::size_t i = 0; i < nSlots; i++ ) {
+
+        Slot* slot = chunks[ i / chunkSize ] + i % chunkSize;
+        if( slot->isAlive ) reinterpret_cast< T* >( &slot->data )->~T();
+
+      }
+
+    }
+
+    nSlots = 0;
+    freeSlots.clear();
+
+  }
+
+  // number of alive objects
+  std::size_t size() const { return nSlots - freeSlots.size(); }
+
+  // is object allocated from this pool
+  bool Owns( const T* object ) const {
+
+    const Slot* slot = reinterpret_cast< const Slot* >( object );
+    std::less< const Slot* > less;
+    for( auto chunk: chunks ) if( not less( slot, chunk ) and less( slot, chunk + chunkSize ) ) return true;
+    return false;
+
+  }
+
+};
+
+#endif //POOL_H
@@ -0,0 +1,122 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include "Snapshot.h"
+
+// fixed capacity circular buffer, memory is allocated once at construction
+// values are added to back and removed from either end, index 0 is the oldest value
+template< class T >
+class RingBuffer {
+
+private:
+
+  std::vector< T > data;
+  std::size_t head  = 0; // position of the oldest value
+  std::size_t count = 0;
+
+  std::size_t Position( std::size_t i ) const {
+
+    i += head;
+    return i < data.size() ? i : i - data.size();
+
+  }
+
+public:
+
+  RingBuffer( std::size_t capacity ) : data( capacity ) {}
+
+  // overwrites the oldest value if buffer is full
+  void PushBack( const T& value ) {
+
+    if( count == data.size() ) {
+
+      data[head] = value;
+      head = Position( 1 );
+
+    } else {
+
+      data[ Position( count ) ] = value;
+      count++;
+
+    }
+
+  }
+
+  void PopFront() { head = Position( 1 ); count--; }
+  void PopBack()  { count--; }
+
+  T& Front() { return data[head]; }
+  T& Back()  { return data[ Position( count - 1 ) ]; }
+
+  const T& Front() const { return data[head]; }
+  const T& Back()  const { return data[ Position( count - 1 ) ]; }
+
+  T&       operator[]( std::size_t i )       { return data[ Position( i ) ]; }
+  const T& operator[]( std::size_t i ) const { return data[ Position( i ) ]; }
+
+  std::size_t size()     const { return count; }
+  std::size_t capacity() const { return data.size(); }
+  bool        empty()    const { return count == 0; }
+  bool        IsFull()   const { return count == data.size(); }
+
+  void clear() { head = 0; count = 0; }
+
+  // grows capacity keeping values, used by windows with no fixed size
+  void Reserve( std::size_t capacity ) {
+
+    if( capacity <= data.size() ) return;
+
+    std::vector< T > grown( capacity );
+    for( std::size_t i = 0; i < count; i++ ) grown[i] = data[ Position( i ) ];
+    data.swap( grown );
+    head = 0;
+
+  }
+
+  // values from oldest to latest, capacity is set by owner before loading and must match saved one
+  void Serialize( Snapshot& snapshot ) {
+
+    std::uint64_t size = count;
+
+    snapshot.Check( (std::uint64_t)data.size() );
+    snapshot.Field( size );
+
+    if( snapshot.IsLoading() ) {
+
+      if( size > data.size() ) throw std::invalid_argument( "snapshot is corrupted" );
+      snapshot.CheckSize< T >( size );
+      std::fill( data.begin(), data.end(), T() );
+      head  = 0;
+      count = size;
+
+    }
+
+    for( std::size_t i = 0; i < count; i++ ) snapshot.Field( data[ Position( i ) ] );
+
+  }
+
+};
+
+#endif //RINGBUFFER_H
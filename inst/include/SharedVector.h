@@ -0,0 +1,161 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+#ifndef SHAREDVECTOR_H
+#define SHAREDVECTOR_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <iterator>
+#include "Snapshot.h"
+
+// append mostly vector whose copies share values, used for history kept by forked processors
+// values are stored in chunks, copy takes O( size / chunkSize ) and marks all chunks shared in both copies
+// shared chunk is copied before it is written so only the last partial chunk is copied after append
+template< class T, std::size_t chunkSize = 1024 >
+class SharedVector {
+
+private:
+
+  typedef std::vector< T > Chunk;
+
+  std::vector< std::shared_ptr< Chunk > > chunks;
+  mutable std::vector< bool > isShared; // chunk may be referenced by another copy
+  std::size_t n = 0;
+
+  Chunk& Own( std::size_t k ) {
+
+    if( isShared[k] ) {
+
+      std::shared_ptr< Chunk > chunk = std::make_shared< Chunk >();
+      chunk->reserve( chunkSize );
+      chunk->assign( chunks[k]->begin(), chunks[k]->end() );
+      chunks[k] = chunk;
+      isShared[k] = false;
+
+    }
+    return *chunks[k];
+
+  }
+
+public:
+
+  class const_iterator {
+
+    const SharedVector* x;
+    std::size_t i;
+
+  public:
+
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T                         value_type;
+    typedef std::ptrdiff_t            difference_type;
+    typedef const T*                  pointer;
+    typedef const T&                  reference;
+
+    const_iterator( const SharedVector* x, std::size_t i ) : x( x ), i( i ) {}
+
+    const T& operator*()  const { return ( *x )[i]; }
+    const T* operator->() const { return &( *x )[i]; }
+
+    const_iterator& operator++()    { i++; return *this; }
+    const_iterator  operator++(int) { const_iterator it = *this; i++; return it; }
+
+    bool operator==( const const_iterator& it ) const { return i == it.i; }
+    bool operator!=( const const_iterator& it ) const { return i != it.i; }
+
+  };
+
+  SharedVector() {}
+
+  SharedVector( const SharedVector& x ) : chunks( x.chunks ), n( x.n ) {
+
+    x.isShared.assign( x.chunks.size(), true );
+    isShared = x.isShared;
+
+  }
+
+  SharedVector& operator=( const SharedVector& x ) {
+
+    if( this == &x ) return *this;
+
+    x.isShared.assign( x.chunks.size(), true );
+    chunks   = x.chunks;
+    isShared = x.isShared;
+    n        = x.n;
+    return *this;
+
+  }
+
+  void push_back( const T& value ) {
+
+    if( n == chunks.size() * chunkSize ) {
+
+      chunks.push_back( std::make_shared< Chunk >() );
+      chunks.back()->reserve( chunkSize );
+      isShared.push_back( false );
+
+    }
+    Own( chunks.size() - 1 ).push_back( value );
+    n++;
+
+  }
+
+  const T& operator[]( std::size_t i ) const { return ( *chunks[ i / chunkSize ] )[ i % chunkSize ]; }
+  const T& back() const { return ( *this )[ n - 1 ]; }
+
+  // copies chunk if shared
+  void Set( std::size_t i, const T& value ) { Own( i / chunkSize )[ i % chunkSize ] = value; }
+
+  std::size_t size()  const { return n; }
+  bool        empty() const { return n == 0; }
+
+  const_iterator begin() const { return const_iterator( this, 0 ); }
+  const_iterator end()   const { return const_iterator( this, n ); }
+
+  void clear() {
+
+    chunks.clear();
+    isShared.clear();
+    n = 0;
+
+  }
+
+  std::vector< T > Get() const {
+
+    std::vector< T > values;
+    values.reserve( n );
+    for( auto& chunk: chunks ) values.insert( values.end(), chunk->begin(), chunk->end() );
+    return values;
+
+  }
+
+  void Serialize( Snapshot& snapshot ) {
+
+    std::vector< T > values = Get();
+    snapshot.Field( values );
+
+    if( not snapshot.IsLoading() ) return;
+
+    clear();
+    for( auto& value: values ) push_back( value );
+
+  }
+
+};
+
+#endif //SHAREDVECTOR_H
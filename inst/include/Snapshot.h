@@ -0,0 +1,163 @@
+// Copyright (C) 2016-2018 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <Rcpp.h>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+// binary state of processor and indicators used to resume test from where previous run stopped
+// each class implements Serialize( Snapshot& ) as one sequence of Field calls
+// the same sequence writes state when snapshot is saved and reads it back when snapshot is loaded
+// layout is not portable between package versions
+class Snapshot {
+
+private:
+
+  static constexpr std::uint32_t version = 1;
+
+  std::vector< char > data;
+  std::size_t position  = 0;
+  bool        isLoading = false;
+
+  void Write( const void* value, std::size_t size ) {
+
+    const char* bytes = static_cast< const char* >( value );
+    data.insert( data.end(), bytes, bytes + size );
+
+  }
+
+  void Read( void* value, std::size_t size ) {
+
+    if( size > data.size() - position ) throw std::invalid_argument( "snapshot is truncated" );
+    std::memcpy( value, data.data() + position, size );
+    position += size;
+
+  }
+
+  void Header() {
+
+    char magic[4] = { 'Q', 'T', 'S', 'S' };
+    std::uint32_t version = Snapshot::version;
+
+    if( not isLoading ) { Write( magic, sizeof( magic ) ); Write( &version, sizeof( version ) ); return; }
+
+    char magicRead[4];
+    Read( magicRead, sizeof( magicRead ) );
+    Read( &version , sizeof( version   ) );
+
+    if( std::memcmp( magic, magicRead, sizeof( magic ) ) != 0 ) throw std::invalid_argument( "not a snapshot" );
+    if( version != Snapshot::version ) throw std::invalid_argument( "snapshot version is not supported" );
+
+  }
+
+  // numbers are copied at once, other values one by one
+  template< typename T >
+  void Values( std::vector< T >& values, std::true_type ) {
+
+    if( values.empty() ) return;
+    if( isLoading ) Read( values.data(), values.size() * sizeof( T ) ); else Write( values.data(), values.size() * sizeof( T ) );
+
+  }
+
+  template< typename T >
+  void Values( std::vector< T >& values, std::false_type ) { for( auto& value: values ) Field( value ); }
+
+public:
+
+  // empty snapshot to save state to
+  Snapshot() { Header(); }
+
+  // saved snapshot to load state from
+  Snapshot( const char* bytes, std::size_t size ) : data( bytes, bytes + size ), isLoading( true ) { Header(); }
+  Snapshot( Rcpp::RawVector snapshot ) : Snapshot( reinterpret_cast< const char* >( snapshot.begin() ), snapshot.size() ) {}
+
+  bool IsLoading() const { return isLoading; }
+
+  // true if everything saved was loaded back
+  bool IsEnd() const { return position == data.size(); }
+
+  template< typename T >
+  typename std::enable_if< std::is_arithmetic< T >::value or std::is_enum< T >::value >::type Field( T& value ) {
+
+    if( isLoading ) Read( &value, sizeof( T ) ); else Write( &value, sizeof( T ) );
+
+  }
+
+  void Field( std::string& value ) {
+
+    std::uint64_t size = value.size();
+    Field( size );
+    if( isLoading ) { CheckSize< char >( size ); value.resize( size ); Read( &value[0], size ); } else Write( value.data(), size );
+
+  }
+
+  template< typename T, typename U >
+  void Field( std::pair< T, U >& value ) {
+
+    Field( value.first  );
+    Field( value.second );
+
+  }
+
+  template< typename T >
+  void Field( std::vector< T >& values ) {
+
+    std::uint64_t size = values.size();
+    Field( size );
+    if( isLoading ) { CheckSize< T >( size ); values.resize( size ); }
+    Values( values, std::is_arithmetic< T >() );
+
+  }
+
+  // throws if loaded number of values can not fit in the rest of snapshot, called before memory for them is allocated
+  // numbers take their size, other values at least one byte
+  template< typename T >
+  void CheckSize( std::uint64_t size ) const {
+
+    std::size_t sizeMin = std::is_arithmetic< T >::value or std::is_enum< T >::value ? sizeof( T ) : 1;
+    if( size > ( data.size() - position ) / sizeMin ) throw std::invalid_argument( "snapshot is truncated" );
+
+  }
+
+  // parameter object was constructed with, saved as is and compared to current one on load
+  template< typename T >
+  void Check( T value ) {
+
+    T saved = value;
+    Field( saved );
+    if( isLoading and saved != value ) throw std::invalid_argument( "snapshot was saved from object with different parameters" );
+
+  }
+
+  std::size_t size() const { return data.size(); }
+
+  // snapshot loading state saved to this one, used to copy objects in memory
+  Snapshot Load() const { return Snapshot( data.data(), data.size() ); }
+
+  Rcpp::RawVector Get() const { return Rcpp::RawVector( data.begin(), data.end() ); }
+
+};
+
+#endif //SNAPSHOT_H
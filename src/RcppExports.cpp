@@ -46,7 +46,7 @@ BEGIN_RCPP
 END_RCPP
 }
 // ema
-std::vector<double> ema(Rcpp::NumericVector x, std::size_t n);
+Rcpp::NumericVector ema(Rcpp::NumericVector x, std::size_t n);
 RcppExport SEXP _QuantTools_ema(SEXP xSEXP, SEXP nSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
@@ -57,6 +57,20 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// ema_by
+Rcpp::NumericVector ema_by(Rcpp::NumericVector x, SEXP by, std::size_t n, int n_threads);
+RcppExport SEXP _QuantTools_ema_by(SEXP xSEXP, SEXP bySEXP, SEXP nSEXP, SEXP n_threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type by(bySEXP);
+    Rcpp::traits::input_parameter< std::size_t >::type n(nSEXP);
+    Rcpp::traits::input_parameter< int >::type n_threads(n_threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(ema_by(x, by, n, n_threads));
+    return rcpp_result_gen;
+END_RCPP
+}
 // na_locf_numeric
 Rcpp::NumericVector na_locf_numeric(Rcpp::NumericVector x);
 RcppExport SEXP _QuantTools_na_locf_numeric(SEXP xSEXP) {
@@ -82,7 +96,7 @@ BEGIN_RCPP
 END_RCPP
 }
 // roll_correlation
-std::vector< double > roll_correlation(Rcpp::NumericVector x, Rcpp::NumericVector y, std::size_t n);
+Rcpp::NumericVector roll_correlation(Rcpp::NumericVector x, Rcpp::NumericVector y, std::size_t n);
 RcppExport SEXP _QuantTools_roll_correlation(SEXP xSEXP, SEXP ySEXP, SEXP nSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
@@ -95,7 +109,7 @@ BEGIN_RCPP
 END_RCPP
 }
 // roll_percent_rank
-std::vector<double> roll_percent_rank(Rcpp::NumericVector x, std::size_t n);
+Rcpp::NumericVector roll_percent_rank(Rcpp::NumericVector x, std::size_t n);
 RcppExport SEXP _QuantTools_roll_percent_rank(SEXP xSEXP, SEXP nSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
@@ -106,6 +120,20 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// roll_percent_rank_by
+Rcpp::NumericVector roll_percent_rank_by(Rcpp::NumericVector x, SEXP by, std::size_t n, int n_threads);
+RcppExport SEXP _QuantTools_roll_percent_rank_by(SEXP xSEXP, SEXP bySEXP, SEXP nSEXP, SEXP n_threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type by(bySEXP);
+    Rcpp::traits::input_parameter< std::size_t >::type n(nSEXP);
+    Rcpp::traits::input_parameter< int >::type n_threads(n_threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_percent_rank_by(x, by, n, n_threads));
+    return rcpp_result_gen;
+END_RCPP
+}
 // roll_range
 Rcpp::List roll_range(Rcpp::NumericVector x, std::size_t n);
 RcppExport SEXP _QuantTools_roll_range(SEXP xSEXP, SEXP nSEXP) {
@@ -170,7 +198,7 @@ BEGIN_RCPP
 END_RCPP
 }
 // roll_sd
-std::vector<double> roll_sd(Rcpp::NumericVector x, std::size_t n);
+Rcpp::NumericVector roll_sd(Rcpp::NumericVector x, std::size_t n);
 RcppExport SEXP _QuantTools_roll_sd(SEXP xSEXP, SEXP nSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
@@ -181,6 +209,45 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// roll_sd_bank
+Rcpp::List roll_sd_bank(Rcpp::NumericVector x, std::vector< int > n);
+RcppExport SEXP _QuantTools_roll_sd_bank(SEXP xSEXP, SEXP nSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< std::vector< int > >::type n(nSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_sd_bank(x, n));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roll_sd_by
+Rcpp::NumericVector roll_sd_by(Rcpp::NumericVector x, SEXP by, std::size_t n, int n_threads);
+RcppExport SEXP _QuantTools_roll_sd_by(SEXP xSEXP, SEXP bySEXP, SEXP nSEXP, SEXP n_threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type by(bySEXP);
+    Rcpp::traits::input_parameter< std::size_t >::type n(nSEXP);
+    Rcpp::traits::input_parameter< int >::type n_threads(n_threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_sd_by(x, by, n, n_threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roll_sd_time
+Rcpp::NumericVector roll_sd_time(Rcpp::NumericVector x, Rcpp::NumericVector time, double seconds);
+RcppExport SEXP _QuantTools_roll_sd_time(SEXP xSEXP, SEXP timeSEXP, SEXP secondsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type time(timeSEXP);
+    Rcpp::traits::input_parameter< double >::type seconds(secondsSEXP);
+    rcpp_result_gen = Rcpp::wrap(roll_sd_time(x, time, seconds));
+    return rcpp_result_gen;
+END_RCPP
+}
 // roll_volume_profile
 Rcpp::List roll_volume_profile(Rcpp::DataFrame ticks, int timeFrame, double step, double alpha, double cut);
 RcppExport SEXP _QuantTools_roll_volume_profile(SEXP ticksSEXP, SEXP timeFrameSEXP, SEXP stepSEXP, SEXP alphaSEXP, SEXP cutSEXP) {
@@ -197,7 +264,7 @@ BEGIN_RCPP
 END_RCPP
 }
 // rsi
-std::vector<double> rsi(Rcpp::NumericVector x, std::size_t n);
+Rcpp::NumericVector rsi(Rcpp::NumericVector x, std::size_t n);
 RcppExport SEXP _QuantTools_rsi(SEXP xSEXP, SEXP nSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
@@ -219,7 +286,7 @@ BEGIN_RCPP
 END_RCPP
 }
 // sma
-std::vector<double> sma(Rcpp::NumericVector x, int n);
+Rcpp::NumericVector sma(Rcpp::NumericVector x, int n);
 RcppExport SEXP _QuantTools_sma(SEXP xSEXP, SEXP nSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
@@ -230,6 +297,31 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// sma_bank
+Rcpp::List sma_bank(Rcpp::NumericVector x, std::vector< int > n);
+RcppExport SEXP _QuantTools_sma_bank(SEXP xSEXP, SEXP nSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< std::vector< int > >::type n(nSEXP);
+    rcpp_result_gen = Rcpp::wrap(sma_bank(x, n));
+    return rcpp_result_gen;
+END_RCPP
+}
+// sma_time
+Rcpp::NumericVector sma_time(Rcpp::NumericVector x, Rcpp::NumericVector time, double seconds);
+RcppExport SEXP _QuantTools_sma_time(SEXP xSEXP, SEXP timeSEXP, SEXP secondsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type time(timeSEXP);
+    Rcpp::traits::input_parameter< double >::type seconds(secondsSEXP);
+    rcpp_result_gen = Rcpp::wrap(sma_time(x, time, seconds));
+    return rcpp_result_gen;
+END_RCPP
+}
 // stochastic
 Rcpp::List stochastic(SEXP x, size_t n, size_t nFast, size_t nSlow);
 RcppExport SEXP _QuantTools_stochastic(SEXP xSEXP, SEXP nSEXP, SEXP nFastSEXP, SEXP nSlowSEXP) {
@@ -244,13 +336,48 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// write_ticks
+void write_ticks(Rcpp::DataFrame ticks, std::string file);
+RcppExport SEXP _QuantTools_write_ticks(SEXP ticksSEXP, SEXP fileSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::DataFrame >::type ticks(ticksSEXP);
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    write_ticks(ticks, file);
+    return R_NilValue;
+END_RCPP
+}
+// read_ticks
+Rcpp::List read_ticks(std::string file, std::string from, std::string to);
+RcppExport SEXP _QuantTools_read_ticks(SEXP fileSEXP, SEXP fromSEXP, SEXP toSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    Rcpp::traits::input_parameter< std::string >::type from(fromSEXP);
+    Rcpp::traits::input_parameter< std::string >::type to(toSEXP);
+    rcpp_result_gen = Rcpp::wrap(read_ticks(file, from, to));
+    return rcpp_result_gen;
+END_RCPP
+}
+// tick_file_dates
+Rcpp::IntegerVector tick_file_dates(std::string file);
+RcppExport SEXP _QuantTools_tick_file_dates(SEXP fileSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    rcpp_result_gen = Rcpp::wrap(tick_file_dates(file));
+    return rcpp_result_gen;
+END_RCPP
+}
 // to_candles
-Rcpp::List to_candles(Rcpp::DataFrame ticks, int timeframe);
+Rcpp::List to_candles(SEXP ticks, int timeframe);
 RcppExport SEXP _QuantTools_to_candles(SEXP ticksSEXP, SEXP timeframeSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Rcpp::DataFrame >::type ticks(ticksSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ticks(ticksSEXP);
     Rcpp::traits::input_parameter< int >::type timeframe(timeframeSEXP);
     rcpp_result_gen = Rcpp::wrap(to_candles(ticks, timeframe));
     return rcpp_result_gen;
@@ -33,8 +33,15 @@ Rcpp::List bbands( Rcpp::NumericVector x, std::size_t n, double k ) {
 
   BBands bbands( n, k );
 
-  for( auto i = 0; i < x.size(); i++ ) bbands.Add( x[i] );
+  Rcpp::NumericVector lower( Rcpp::no_init( x.size() ) );
+  Rcpp::NumericVector upper( Rcpp::no_init( x.size() ) );
+  Rcpp::NumericVector sma  ( Rcpp::no_init( x.size() ) );
+  bbands.Bulk( x.begin(), x.size(), lower.begin(), upper.begin(), sma.begin() );
 
-  return bbands.GetHistory();
+  Rcpp::List history = ListBuilder().AsDataTable()
+    .Add( "lower", lower )
+    .Add( "upper", upper )
+    .Add( "sma"  , sma   );
+  return history;
 
 }
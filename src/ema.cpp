@@ -16,22 +16,42 @@
 // along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
 
 #include "../inst/include/Indicators/Ema.h"
+#include "../inst/include/Groups.h"
 
 //' Exponential Moving Average
 //'
 //' @param x numeric vectors
 //' @param n window size
+//' @param by group of each value, rows of each group must be contiguous, e.g. sorted by group
+//' @param n_threads number of threads, 0 to use all cores
 //' @family technical indicators
 //' @description Exponentially weighted moving average aka EMA is exponentially weighted SMA. EMAs have faster response to recent value changes than SMAs.
+//' \cr ema_by calculates EMA of each group independently, groups are processed in parallel.
 //' @export
 // [[Rcpp::export]]
-std::vector<double> ema( Rcpp::NumericVector x, std::size_t n ) {
+Rcpp::NumericVector ema( Rcpp::NumericVector x, std::size_t n ) {
 
   Ema ema( n );
 
-  for( auto i = 0; i < x.size(); i++ ) ema.Add( x[i] );
+  Rcpp::NumericVector values( Rcpp::no_init( x.size() ) );
+  ema.Bulk( x.begin(), x.size(), values.begin() );
 
-  return ema.GetHistory();
+  return values;
+
+}
+//' @rdname ema
+//' @export
+// [[Rcpp::export]]
+Rcpp::NumericVector ema_by( Rcpp::NumericVector x, SEXP by, std::size_t n, int n_threads = 0 ) {
+
+  Ema ema( n );
+  Groups groups( by );
+  if( groups.nRows() != ( std::size_t )x.size() ) throw std::invalid_argument( "x and by must have the same length" );
+
+  Rcpp::NumericVector values( Rcpp::no_init( x.size() ) );
+  groups.Apply( x.begin(), values.begin(), n_threads, [&]( const double* group, std::size_t size, double* out ) { ema.Bulk( group, size, out ); } );
+
+  return values;
 
 }
 //' @name ema
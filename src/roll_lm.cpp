@@ -30,22 +30,36 @@
 // [[Rcpp::export]]
 Rcpp::List roll_lm( Rcpp::NumericVector x, Rcpp::NumericVector y, std::size_t n ) {
 
+  if( x.size() != y.size() ) throw std::invalid_argument( "x and y must have the same length" );
+
   RollLinReg lm( n );
 
-  for( auto i = 0; i < x.size(); i++ ) lm.Add( std::pair< double, double >( x[i], y[i] ) );
+  Rcpp::NumericVector alpha   ( Rcpp::no_init( x.size() ) );
+  Rcpp::NumericVector beta    ( Rcpp::no_init( x.size() ) );
+  Rcpp::NumericVector r       ( Rcpp::no_init( x.size() ) );
+  Rcpp::NumericVector rSquared( Rcpp::no_init( x.size() ) );
+  lm.Bulk( x.begin(), y.begin(), x.size(), alpha.begin(), beta.begin(), r.begin(), rSquared.begin() );
 
-  return lm.GetHistory();
+  Rcpp::List history = ListBuilder().AsDataTable()
+    .Add( "alpha"    , alpha    )
+    .Add( "beta"     , beta     )
+    .Add( "r"        , r        )
+    .Add( "r.squared", rSquared );
+  return history;
 
 }
 //' @rdname roll_lm
 //' @export
 // [[Rcpp::export]]
-std::vector< double > roll_correlation( Rcpp::NumericVector x, Rcpp::NumericVector y, std::size_t n ) {
+Rcpp::NumericVector roll_correlation( Rcpp::NumericVector x, Rcpp::NumericVector y, std::size_t n ) {
+
+  if( x.size() != y.size() ) throw std::invalid_argument( "x and y must have the same length" );
 
   RollLinReg lm( n );
 
-  for( auto i = 0; i < x.size(); i++ ) lm.Add( std::pair< double, double >( x[i], y[i] ) );
+  Rcpp::NumericVector r( Rcpp::no_init( x.size() ) );
+  lm.Bulk( x.begin(), y.begin(), x.size(), nullptr, nullptr, r.begin(), nullptr );
 
-  return lm.GetRHistory();
+  return r;
 
 }
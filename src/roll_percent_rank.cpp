@@ -16,22 +16,43 @@
 // along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
 
 #include "../inst/include/Indicators/RollPercentRank.h"
+#include "../inst/include/Groups.h"
 
 //' Rolling Percent Rank
 //'
 //' @name roll_percent_rank
 //' @param x numeric vector
 //' @param n window size
+//' @param by group of each value, rows of each group must be contiguous, e.g. sorted by group
+//' @param n_threads number of threads, 0 to use all cores
 //' @family technical indicators
 //' @description Rolling percent rank normalizes values to a range from 0 to 100.
+//' \cr roll_percent_rank_by calculates percent rank of each group independently, groups are processed in parallel.
 //' @export
 // [[Rcpp::export]]
-std::vector<double> roll_percent_rank( Rcpp::NumericVector x, std::size_t n ) {
+Rcpp::NumericVector roll_percent_rank( Rcpp::NumericVector x, std::size_t n ) {
 
   RollPercentRank percentRank( n );
 
-  for( auto i = 0; i < x.size(); i++ ) percentRank.Add( x[i] );
+  Rcpp::NumericVector values( Rcpp::no_init( x.size() ) );
+  percentRank.Bulk( x.begin(), x.size(), values.begin() );
 
-  return percentRank.GetHistory();
+  return values;
+
+}
+//' @rdname roll_percent_rank
+//' @export
+// [[Rcpp::export]]
+Rcpp::NumericVector roll_percent_rank_by( Rcpp::NumericVector x, SEXP by, std::size_t n, int n_threads = 0 ) {
+
+  RollPercentRank percentRank( n );
+  Groups groups( by );
+  if( groups.nRows() != ( std::size_t )x.size() ) throw std::invalid_argument( "x and by must have the same length" );
+
+  // bulk ranking reuses indicator workspace so each group ranks in its own copy
+  Rcpp::NumericVector values( Rcpp::no_init( x.size() ) );
+  groups.Apply( x.begin(), values.begin(), n_threads, [&]( const double* group, std::size_t size, double* out ) { RollPercentRank rank = percentRank; rank.Bulk( group, size, out ); } );
+
+  return values;
 
 }
@@ -16,22 +16,88 @@
 // along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
 
 #include "../inst/include/Indicators/RollSd.h"
+#include "../inst/include/Indicators/RollSdBank.h"
+#include "../inst/include/Indicators/RollSdTime.h"
+#include "../inst/include/Groups.h"
 
 //' Rolling Standard Deviation
 //'
 //' @name roll_sd
 //' @param x numeric vector
-//' @param n window size
+//' @param n window size, window sizes for roll_sd_bank
+//' @param by group of each value, rows of each group must be contiguous, e.g. sorted by group
+//' @param n_threads number of threads, 0 to use all cores
+//' @param time numeric vector of value times in seconds, e.g. \code{POSIXct}, must be finite and not decrease
+//' @param seconds window length in seconds for \code{_time} version
 //' @family technical indicators
+//' @return roll_sd, roll_sd_by and roll_sd_time return numeric vector
+//' \cr roll_sd_bank returns data.table with column \code{sd_<n>} for each window size
 //' @description Rolling standard deviation shows standard deviation over n past values.
+//' \cr roll_sd_bank calculates deviations of several window sizes in one pass.
+//' \cr roll_sd_by calculates deviation of each group independently, groups are processed in parallel.
+//' \cr roll_sd_time calculates deviation of values of last \code{seconds} of irregular time series such as ticks.
 //' @export
 // [[Rcpp::export]]
-std::vector<double> roll_sd( Rcpp::NumericVector x, std::size_t n ) {
+Rcpp::NumericVector roll_sd( Rcpp::NumericVector x, std::size_t n ) {
 
   RollSd sd( n );
 
-  for( auto i = 0; i < x.size(); i++ ) sd.Add( x[i] );
+  Rcpp::NumericVector values( Rcpp::no_init( x.size() ) );
+  sd.Bulk( x.begin(), x.size(), values.begin() );
 
-  return sd.GetHistory();
+  return values;
+
+}
+//' @rdname roll_sd
+//' @export
+// [[Rcpp::export]]
+Rcpp::List roll_sd_bank( Rcpp::NumericVector x, std::vector< int > n ) {
+
+  RollSdBank bank( n );
+
+  std::vector< Rcpp::NumericVector > columns;
+  std::vector< double* > out;
+  columns.reserve( n.size() );
+  for( std::size_t i = 0; i < n.size(); i++ ) {
+
+    columns.push_back( Rcpp::NumericVector( Rcpp::no_init( x.size() ) ) );
+    out.push_back( columns.back().begin() );
+
+  }
+  bank.Bulk( x.begin(), x.size(), out );
+
+  ListBuilder history;
+  history.AsDataTable();
+  for( std::size_t i = 0; i < n.size(); i++ ) history.Add( "sd_" + std::to_string( n[i] ), columns[i] );
+  return history;
+
+}
+//' @rdname roll_sd
+//' @export
+// [[Rcpp::export]]
+Rcpp::NumericVector roll_sd_by( Rcpp::NumericVector x, SEXP by, std::size_t n, int n_threads = 0 ) {
+
+  RollSd sd( n );
+  Groups groups( by );
+  if( groups.nRows() != ( std::size_t )x.size() ) throw std::invalid_argument( "x and by must have the same length" );
+
+  Rcpp::NumericVector values( Rcpp::no_init( x.size() ) );
+  groups.Apply( x.begin(), values.begin(), n_threads, [&]( const double* group, std::size_t size, double* out ) { sd.Bulk( group, size, out ); } );
+
+  return values;
+
+}
+//' @rdname roll_sd
+//' @export
+// [[Rcpp::export]]
+Rcpp::NumericVector roll_sd_time( Rcpp::NumericVector x, Rcpp::NumericVector time, double seconds ) {
+
+  RollSdTime sd( seconds );
+  if( time.size() != x.size() ) throw std::invalid_argument( "x and time must have the same length" );
+
+  Rcpp::NumericVector values( Rcpp::no_init( x.size() ) );
+  sd.Bulk( time.begin(), x.begin(), x.size(), values.begin() );
+
+  return values;
 
 }
@@ -33,6 +33,7 @@ std::vector< bool > roll_sd_filter( Rcpp::NumericVector x, int n, double k = 1,
   filter.push_back( false );
 
   RollSd sd( n );
+  sd.SetHistoryMode( HistoryMode::NONE );
 
   int j = 0;
   for( int i = 1; i < x.size(); i++ ) {
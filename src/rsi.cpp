@@ -25,13 +25,14 @@
 //' @description Relative strength index aka RSI measures the velocity and magnitude of directional price movements.
 //' @export
 // [[Rcpp::export]]
-std::vector<double> rsi( Rcpp::NumericVector x, std::size_t n ) {
+Rcpp::NumericVector rsi( Rcpp::NumericVector x, std::size_t n ) {
 
   Rsi rsi( n );
 
-  for( auto i = 0; i < x.size(); i++ ) rsi.Add( x[i] );
+  Rcpp::NumericVector values( Rcpp::no_init( x.size() ) );
+  rsi.Bulk( x.begin(), x.size(), values.begin() );
 
-  return rsi.GetHistory();
+  return values;
 
 }
 //' @name rsi
@@ -18,6 +18,7 @@
 #include <Rcpp.h>
 #include <vector>
 #include "../inst/include/BackTest.h"
+#include "../inst/include/BackTest/ProcessorMulti.h"
 #include "../inst/include/setDT.h"
 using namespace Rcpp;
 
@@ -442,6 +443,694 @@ private:
     return( errors );
 
   };
+  int test_06() {
+    Rcout << "Test 06 - Snapshot - Resume" << std::endl;
+
+    int errors = 0;
+
+    double latencySend = 0.2;
+    double latencyReceive = 0.1;
+    Processor processor( 10, latencySend, latencyReceive );
+
+    processor.SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "long", 1 ) );
+    processor.SendOrder( new Order( OrderSide::SELL, OrderType::LIMIT, 12, "close long", 1 ) );
+
+    Tick tick;
+    tick.id = 1;
+    tick.time = 0;
+    tick.price = 10;
+    tick.volume = 100;
+    for( int i = 0; i < 5; i++ ) {
+      processor.Feed( tick );
+      tick.id++;
+      tick.time += 1;
+    }
+    // long opened and limit order waits for price
+    if( processor.GetPosition() != 1 )
+      Rcout << "1.1 position not 1 - " << ++errors << std::endl;
+    if( processor.ordersRising.size() != 1 )
+      Rcout << "1.2 limit order not parked - " << ++errors << std::endl;
+
+    Snapshot saved;
+    processor.Serialize( saved );
+    Rcpp::RawVector raw = saved.Get();
+
+    Processor resumed( 10, latencySend, latencyReceive );
+    Snapshot loaded( raw );
+    resumed.Serialize( loaded );
+    if( !loaded.IsEnd() )
+      Rcout << "2.1 snapshot not loaded to end - " << ++errors << std::endl;
+    if( resumed.GetPosition() != 1 or resumed.ordersRising.size() != 1 or resumed.ordersProcessed.size() != 1 )
+      Rcout << "2.2 orders not restored - " << ++errors << std::endl;
+
+    std::vector< double > prices = { 11, 13, 13, 13 };
+    for( auto price: prices ) {
+      tick.price = price;
+      processor.Feed( tick );
+      resumed  .Feed( tick );
+      tick.id++;
+      tick.time += 1;
+    }
+    // limit order executed in both processors
+    if( resumed.GetPosition() != 0 or resumed.ordersProcessed.size() != 2 )
+      Rcout << "3.1 limit order not executed - " << ++errors << std::endl;
+    if( resumed.ordersProcessed[1]->priceExecuted != processor.ordersProcessed[1]->priceExecuted or resumed.ordersProcessed[1]->idProcessed != processor.ordersProcessed[1]->idProcessed )
+      Rcout << "3.2 execution differs - " << ++errors << std::endl;
+    if( resumed.statistics.totalPnl != processor.statistics.totalPnl or resumed.statistics.nTradesTotal != 1 )
+      Rcout << "3.3 statistics differ - " << ++errors << std::endl;
+
+    Sma sma( 3 );
+    sma.Add( 1 );
+    sma.Add( 2 );
+    Snapshot savedSma;
+    sma.Serialize( savedSma );
+    Sma smaResumed( 3 );
+    Snapshot loadedSma( savedSma.Get() );
+    smaResumed.Serialize( loadedSma );
+    sma       .Add( 6 );
+    smaResumed.Add( 6 );
+    if( !smaResumed.IsFormed() or smaResumed.GetValue() != sma.GetValue() )
+      Rcout << "4.1 indicator not restored - " << ++errors << std::endl;
+
+    bool isThrown = false;
+    try {
+      Sma smaOther( 4 );
+      Snapshot loadedOther( savedSma.Get() );
+      smaOther.Serialize( loadedOther );
+    } catch( std::invalid_argument& e ) { isThrown = true; }
+    if( !isThrown )
+      Rcout << "4.2 indicator with different period loaded - " << ++errors << std::endl;
+
+    // corrupted sizes are reported before memory is allocated
+    std::uint64_t sizeHuge = 1e15;
+    Snapshot savedHuge;
+    savedHuge.Field( sizeHuge );
+    auto isTruncated = [&savedHuge]( std::function< void( Snapshot& ) > load ) {
+      try {
+        Snapshot loaded( savedHuge.Get() );
+        load( loaded );
+      } catch( std::invalid_argument& e ) { return std::string( e.what() ) == "snapshot is truncated"; }
+      return false;
+    };
+    if( not isTruncated( []( Snapshot& s ) { std::vector< double > v; s.Field( v ); } ) or
+        not isTruncated( []( Snapshot& s ) { std::vector< std::string > v; s.Field( v ); } ) or
+        not isTruncated( []( Snapshot& s ) { std::string v; s.Field( v ); } ) )
+      Rcout << "5.1 corrupted size not reported - " << ++errors << std::endl;
+
+    // ring buffer capacity is set by owner so saved one is not allocated
+    Snapshot savedRing;
+    savedRing.Field( sizeHuge );
+    savedRing.Field( sizeHuge );
+    try {
+      RingBuffer< double > ring( 3 );
+      Snapshot loadedRing( savedRing.Get() );
+      ring.Serialize( loadedRing );
+      Rcout << "5.2 corrupted ring buffer loaded - " << ++errors << std::endl;
+    } catch( std::invalid_argument& e ) {
+    } catch( std::exception& e ) {
+      Rcout << "5.3 corrupted ring buffer allocated - " << ++errors << std::endl;
+    }
+
+    if( errors == 0 ) {
+      Rcout << "Test 06 - PASSED!" << std::endl;
+    } else {
+      Rcout << "Test 06 - FAILED! Errors: " << errors << std::endl;
+    }
+    return( errors );
+
+  };
+  int test_07() {
+    Rcout << "Test 07 - Processor - Fork" << std::endl;
+
+    int errors = 0;
+
+    double latencySend = 0.2;
+    double latencyReceive = 0.1;
+    Processor processor( 10, latencySend, latencyReceive );
+
+    processor.SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "long", 1 ) );
+    Order* limit = new Order( OrderSide::SELL, OrderType::LIMIT, 12, "close long", 1 );
+    processor.SendOrder( limit );
+
+    Tick tick;
+    tick.id = 1;
+    tick.time = 0;
+    tick.price = 10;
+    tick.volume = 100;
+    for( int i = 0; i < 5; i++ ) {
+      processor.Feed( tick );
+      tick.id++;
+      tick.time += 1;
+    }
+
+    Processor* fork = processor.Fork();
+
+    // processed orders shared and live order copied
+    if( fork->ordersProcessed.size() != 1 or fork->ordersProcessed[0] != processor.ordersProcessed[0] )
+      Rcout << "1.1 processed orders not shared - " << ++errors << std::endl;
+    Order* limitForked = fork->GetForkedOrder( limit );
+    if( limitForked == nullptr or limitForked == limit or limitForked->price != 12 or fork->ordersRising.size() != 1 )
+      Rcout << "1.2 live order not copied - " << ++errors << std::endl;
+    if( fork->GetPosition() != 1 )
+      Rcout << "1.3 position not 1 - " << ++errors << std::endl;
+
+    // fork cancels limit order while parent executes it
+    limitForked->Cancel();
+    std::vector< double > prices = { 11, 13, 13, 13 };
+    for( auto price: prices ) {
+      tick.price = price;
+      processor.Feed( tick );
+      fork    ->Feed( tick );
+      tick.id++;
+      tick.time += 1;
+    }
+    if( processor.GetPosition() != 0 or processor.statistics.nTradesTotal != 1 )
+      Rcout << "2.1 parent limit order not executed - " << ++errors << std::endl;
+    if( fork->GetPosition() != 1 or fork->statistics.nTradesTotal != 0 or !limitForked->IsCancelled() )
+      Rcout << "2.2 fork limit order not cancelled - " << ++errors << std::endl;
+    if( limit->IsCancelled() )
+      Rcout << "2.3 parent order changed by fork - " << ++errors << std::endl;
+
+    // fork outlives parent
+    processor.Reset();
+    tick.price = 9;
+    fork->Feed( tick );
+    if( fork->ordersProcessed.size() != 2 or fork->ordersProcessed[0]->comment != "long" )
+      Rcout << "3.1 shared orders released with parent - " << ++errors << std::endl;
+
+    delete fork;
+
+    if( errors == 0 ) {
+      Rcout << "Test 07 - PASSED!" << std::endl;
+    } else {
+      Rcout << "Test 07 - FAILED! Errors: " << errors << std::endl;
+    }
+    return( errors );
+
+  };
+  int test_08() {
+    Rcout << "Test 08 - Processor - Summary only" << std::endl;
+
+    int errors = 0;
+
+    Processor processor( 60 );
+    Processor summary( 60 );
+    summary.RecordSummaryOnly();
+
+    Tick tick;
+    tick.id = 0;
+    tick.time = 0;
+    tick.volume = 100;
+    tick.system = false;
+
+    // one round trip a day, closed trade id is reused by the last order of the day
+    for( int day = 0; day < 3; day++ ) {
+      for( int i = 0; i < 100; i++ ) {
+        tick.price = 10 + day + ( i % 7 ) * 0.1;
+        for( auto bt: { &processor, &summary } ) {
+          if( i == 10 ) bt->SendOrder( new Order( OrderSide::BUY , OrderType::MARKET, NA_REAL, "long"      , day ) );
+          if( i == 50 ) bt->SendOrder( bt->NewOrder( OrderSide::SELL, OrderType::MARKET, NA_REAL, "close long", day ) );
+          if( i == 80 ) bt->SendOrder( new Order( OrderSide::SELL, OrderType::LIMIT , 100    , "late"      , day ) );
+          if( i == 90 ) bt->CancelOrders();
+          bt->Feed( tick );
+        }
+        tick.id++;
+        tick.time += 30;
+      }
+      tick.time += nSecondsInDay;
+    }
+    processor.Finalize();
+    summary.Finalize();
+
+    Statistics& s = summary.statistics;
+    Statistics& p = processor.statistics;
+    if( s.nDaysTested != p.nDaysTested or s.nTradesTotal != p.nTradesTotal or s.totalPnl != p.totalPnl or s.maxDrawDown != p.maxDrawDown or s.sharpe != p.sharpe )
+      Rcout << "1.1 summary differs - " << ++errors << std::endl;
+    if( p.nTradesTotal != 3 or summary.GetPosition() != 0 )
+      Rcout << "1.2 closed trade reopened - " << ++errors << std::endl;
+    if( not summary.ordersProcessed.empty() or not summary.tradesProcessed.empty() or not summary.candles.empty() or not s.onCandleHistoryMarketValue.empty() or not s.onDayCloseHistoryMarketValue.empty() )
+      Rcout << "2.1 history kept - " << ++errors << std::endl;
+    if( summary.memory->orderPool.size() != 0 or summary.memory->tradePool.size() != 0 )
+      Rcout << "2.2 orders or trades not released - " << ++errors << std::endl;
+
+    if( errors == 0 ) {
+      Rcout << "Test 08 - PASSED!" << std::endl;
+    } else {
+      Rcout << "Test 08 - FAILED! Errors: " << errors << std::endl;
+    }
+    return( errors );
+
+  };
+  int test_09() {
+    Rcout << "Test 09 - Processor - Early termination" << std::endl;
+
+    int errors = 0;
+
+    // price falls for 5 days, trading stops on the first loss
+    std::vector< double > time, price;
+    std::vector< int > volume;
+    for( int i = 0; i < 5000; i++ ) {
+      time  .push_back( i * 90. );
+      price .push_back( 100 - i * 0.01 );
+      volume.push_back( 1 );
+    }
+    Ticks ticks( time.size(), time.data(), price.data(), volume.data(), nullptr, nullptr, nullptr );
+    ticks.SetTimeZone( "UTC" );
+
+    Processor processor( 60 );
+    Processor summary( 60 );
+    summary.RecordSummaryOnly();
+
+    // callbacks after trading is stopped and position is closed
+    std::map< Processor*, int > nCandles, nCandlesOver;
+    for( auto bt: { &processor, &summary } ) {
+      bt->stopTradingLoss = -0.001;
+      bt->onCandle = [bt,&nCandles,&nCandlesOver]( Candle candle ) {
+        if( bt->CanTrade() and bt->GetPositionPlanned() == 0 and bt->GetPosition() == 0 ) bt->SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "long", 1 ) );
+        if( not bt->CanTrade() and bt->GetPosition() == 0 ) nCandlesOver[bt]++;
+        nCandles[bt]++;
+      };
+      bt->FeedChunk( ticks.Slice( 0, 2000 ) );
+      bt->Feed( ticks.Slice( 2000, 5000 ) );
+    }
+
+    Statistics& s = summary.statistics;
+    Statistics& p = processor.statistics;
+    if( s.nDaysTested != p.nDaysTested or s.testEnd != p.testEnd or s.totalPnl != p.totalPnl or s.avgDrawDown != p.avgDrawDown or s.sharpe != p.sharpe )
+      Rcout << "1.1 summary differs - " << ++errors << std::endl;
+    if( p.nDaysTested != 6 or p.nTradesTotal != 1 or p.testEnd != time.back() )
+      Rcout << "1.2 stop not tested - " << ++errors << std::endl;
+    if( nCandles[&processor] != (int)processor.candles.size() or nCandlesOver[&processor] == 0 or nCandlesOver[&summary] != 0 )
+      Rcout << "2.1 ticks not skipped after stop - " << ++errors << std::endl;
+
+    // one sided quotes make flat market value not a number until the next two sided quote
+    std::vector< double > bid, ask;
+    for( int i = 0; i < 5000; i++ ) {
+      bid.push_back( price[i] - 0.01 );
+      ask.push_back( i % 97 == 0 or i % 1000 > 990 ? NA_REAL : price[i] + 0.01 );
+    }
+    Ticks quotes( time.size(), time.data(), price.data(), volume.data(), bid.data(), ask.data(), nullptr );
+    quotes.SetTimeZone( "UTC" );
+
+    Processor processorBBO( 60 );
+    Processor summaryBBO( 60 );
+    summaryBBO.RecordSummaryOnly();
+
+    for( auto bt: { &processorBBO, &summaryBBO } ) {
+      bt->SetExecutionType( ExecutionType::BBO );
+      bt->stopTradingLoss = -0.001;
+      bt->onCandle = [bt,&nCandlesOver]( Candle candle ) {
+        if( bt->CanTrade() and bt->GetPositionPlanned() == 0 and bt->GetPosition() == 0 ) bt->SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "long", 1 ) );
+        if( not bt->CanTrade() and bt->GetPosition() == 0 ) nCandlesOver[bt]++;
+      };
+      bt->FeedChunk( quotes.Slice( 0, 2000 ) );
+      bt->Feed( quotes.Slice( 2000, 5000 ) );
+    }
+
+    auto eq = []( double x, double y ) { return x == y or ( std::isnan( x ) and std::isnan( y ) ); };
+    Statistics& sBBO = summaryBBO.statistics;
+    Statistics& pBBO = processorBBO.statistics;
+    if( pBBO.nTradesTotal != 1 or sBBO.nDaysTested != pBBO.nDaysTested or not eq( sBBO.totalPnl, pBBO.totalPnl ) or not eq( sBBO.marketValue, pBBO.marketValue ) or
+        not eq( sBBO.maxDrawDown, pBBO.maxDrawDown ) or not eq( sBBO.avgDrawDown, pBBO.avgDrawDown ) or not eq( sBBO.sharpe, pBBO.sharpe ) or not eq( sBBO.sortino, pBBO.sortino ) )
+      Rcout << "3.1 summary differs on one sided quotes - " << ++errors << std::endl;
+    if( nCandlesOver[&processorBBO] == 0 or nCandlesOver[&summaryBBO] != 0 )
+      Rcout << "3.2 callbacks called after stop on one sided quotes - " << ++errors << std::endl;
+
+    // unordered ticks after stop are reported as when fed one by one
+    time[4000] = time[3000];
+    Processor unordered( 60 );
+    unordered.RecordSummaryOnly();
+    unordered.stopTradingLoss = -0.001;
+    unordered.onCandle = [&unordered]( Candle candle ) {
+      if( unordered.CanTrade() and unordered.GetPositionPlanned() == 0 and unordered.GetPosition() == 0 ) unordered.SendOrder( new Order( OrderSide::BUY, OrderType::MARKET, NA_REAL, "long", 1 ) );
+    };
+    try {
+      unordered.Feed( ticks );
+      Rcout << "4.1 unordered ticks accepted - " << ++errors << std::endl;
+    } catch( const std::invalid_argument& e ) {
+      if( std::string( e.what() ) != "ticks must be time ordered tick.id = 4001" )
+        Rcout << "4.2 unordered ticks reported wrong - " << ++errors << std::endl;
+    }
+
+    if( errors == 0 ) {
+      Rcout << "Test 09 - PASSED!" << std::endl;
+    } else {
+      Rcout << "Test 09 - FAILED! Errors: " << errors << std::endl;
+    }
+    return( errors );
+
+  };
+  int test_10() {
+    Rcout << "Test 10 - Processor - Idle ticks" << std::endl;
+
+    int errors = 0;
+
+    // saw price over 2 days, strategy holds position for 10 of every 50 candles
+    std::vector< double > time, price;
+    std::vector< int > volume;
+    for( int i = 0; i < 20000; i++ ) {
+      time  .push_back( i * 9. );
+      price .push_back( 100 + ( i % 700 ) * 0.01 - ( i % 300 ) * 0.02 );
+      volume.push_back( 1 + i % 5 );
+    }
+    Ticks ticks( time.size(), time.data(), price.data(), volume.data(), nullptr, nullptr, nullptr );
+    ticks.SetTimeZone( "UTC" );
+
+    Processor chunk( 60 );
+    Processor tickByTick( 60 );
+
+    std::map< Processor*, int > nCandles;
+    for( auto bt: { &chunk, &tickByTick } ) {
+      bt->SetTradingHours( 1, 23 );
+      bt->onCandle = [bt,&nCandles]( Candle candle ) {
+        int k = nCandles[bt] % 50, idTrade = nCandles[bt]++ / 50 + 1;
+        if( k == 0 and bt->GetPositionPlanned() == 0 ) bt->SendOrder( new Order( OrderSide::BUY , OrderType::LIMIT , candle.close - 0.01, "long", idTrade ) );
+        if( k == 10 and bt->GetPositionPlanned() != 0 ) bt->SendOrder( new Order( OrderSide::SELL, OrderType::MARKET, NA_REAL, "close", idTrade ) );
+      };
+    }
+    chunk.FeedChunk( ticks.Slice( 0, 7000 ) );
+    chunk.FeedChunk( ticks.Slice( 7000, 20000 ) );
+    chunk.Finalize();
+
+    Tick tick;
+    for( std::size_t i = 0; i < ticks.size(); i++ ) {
+      ticks.Get( i, tick );
+      tick.id = i;
+      tickByTick.Feed( tick );
+    }
+    tickByTick.Finalize();
+
+    auto& a = chunk.candles;
+    auto& b = tickByTick.candles;
+    if( a.size() != b.size() )
+      Rcout << "1.1 candles number differs - " << ++errors << std::endl;
+    for( std::size_t i = 0; i < std::min( a.size(), b.size() ); i++ ) {
+      if( a[i].time != b[i].time or a[i].open != b[i].open or a[i].high != b[i].high or a[i].low != b[i].low or a[i].close != b[i].close or a[i].volume != b[i].volume or a[i].id != b[i].id ) {
+        Rcout << "1.2 candle " << i << " differs - " << ++errors << std::endl;
+        break;
+      }
+    }
+
+    Statistics& s = chunk.statistics;
+    Statistics& p = tickByTick.statistics;
+    if( s.nTradesTotal != p.nTradesTotal or s.nDaysTested != p.nDaysTested or s.testEnd != p.testEnd or s.totalPnl != p.totalPnl or s.maxDrawDown != p.maxDrawDown )
+      Rcout << "2.1 statistics differ - " << ++errors << std::endl;
+    if( p.nTradesTotal < 10 )
+      Rcout << "2.2 strategy not tested - " << ++errors << std::endl;
+
+    if( errors == 0 ) {
+      Rcout << "Test 10 - PASSED!" << std::endl;
+    } else {
+      Rcout << "Test 10 - FAILED! Errors: " << errors << std::endl;
+    }
+    return( errors );
+
+  };
+  int test_11() {
+    Rcout << "Test 11 - Processor - Parked Orders" << std::endl;
+
+    int errors = 0;
+
+    Tick tick;
+    tick.id = 0;
+    tick.time = 0;
+    tick.volume = 1;
+
+    auto feed = [&]( Processor& processor, double price, double bid, double ask ) {
+      tick.id++;
+      tick.time += 1;
+      tick.price = price;
+      tick.bid   = bid;
+      tick.ask   = ask;
+      processor.Feed( tick );
+    };
+
+    // trade execution
+    Processor trade( 60 );
+
+    Order* buyLimit = new Order( OrderSide::BUY , OrderType::LIMIT, 10, "buy limit", 1 );
+    Order* sellStop = new Order( OrderSide::SELL, OrderType::STOP , 8 , "sell stop", 2 );
+    trade.SendOrder( buyLimit );
+    trade.SendOrder( sellStop );
+
+    feed( trade, 11, NAN, NAN );
+    feed( trade, 11, NAN, NAN );
+    if( trade.ordersFalling.size() != 2 or not buyLimit->isParked or not sellStop->isParked )
+      Rcout << "1.1 registered orders not parked - " << ++errors << std::endl;
+
+    feed( trade, 10, NAN, NAN );
+    feed( trade, 10, NAN, NAN );
+    if( not buyLimit->IsRegistered() )
+      Rcout << "1.2 limit executed at its price - " << ++errors << std::endl;
+
+    feed( trade, 9.9, NAN, NAN );
+    feed( trade, 9.9, NAN, NAN );
+    if( not buyLimit->IsExecuted() or buyLimit->priceExecuted != 10 )
+      Rcout << "1.3 limit not executed - " << ++errors << std::endl;
+    if( not sellStop->IsRegistered() or not sellStop->isParked )
+      Rcout << "1.4 stop not parked - " << ++errors << std::endl;
+
+    feed( trade, 7.9, NAN, NAN );
+    feed( trade, 7.8, NAN, NAN );
+    feed( trade, 7.8, NAN, NAN );
+    if( not sellStop->IsExecuted() or sellStop->priceExecuted != 7.8 )
+      Rcout << "1.5 stop not executed - " << ++errors << std::endl;
+
+    // bbo execution, orders are checked against bid and ask of previous tick
+    tick.time = 0;
+    Processor bbo( 60 );
+    bbo.SetExecutionType( ExecutionType::BBO );
+
+    Order* buyLimitBBO = new Order( OrderSide::BUY , OrderType::LIMIT, 10, "buy limit", 1 );
+    Order* buyStopBBO  = new Order( OrderSide::BUY , OrderType::STOP , 12, "buy stop" , 2 );
+    Order* sellLimitBBO= new Order( OrderSide::SELL, OrderType::LIMIT, 13, "sell limit", 3 );
+    bbo.SendOrder( buyLimitBBO  );
+    bbo.SendOrder( buyStopBBO   );
+    bbo.SendOrder( sellLimitBBO );
+
+    // bid is not known, ask alone reaches buy orders
+    feed( bbo, 11, NAN, 11 );
+    feed( bbo, 11, NAN, 11 );
+    feed( bbo, 11, NAN, 11 );
+    if( bbo.ordersFalling.size() != 1 or bbo.ordersRising.size() != 2 )
+      Rcout << "2.1 registered orders not parked - " << ++errors << std::endl;
+
+    feed( bbo, 10, NAN, 10 );
+    feed( bbo, 10, NAN, 10 );
+    feed( bbo, 10, NAN, 10 );
+    if( not buyLimitBBO->IsExecuted() or buyLimitBBO->priceExecuted != 10 )
+      Rcout << "2.2 limit not executed by ask - " << ++errors << std::endl;
+
+    feed( bbo, 12.5, NAN, 12.5 );
+    feed( bbo, 12.5, NAN, 12.5 );
+    feed( bbo, 12.5, NAN, 12.5 );
+    feed( bbo, 12.5, NAN, 12.5 );
+    if( not buyStopBBO->IsExecuted() or buyStopBBO->priceExecuted != 12.5 )
+      Rcout << "2.3 stop not executed by ask - " << ++errors << std::endl;
+    if( not sellLimitBBO->IsRegistered() or not sellLimitBBO->isParked )
+      Rcout << "2.4 sell limit woken by ask - " << ++errors << std::endl;
+
+    // ask is not known, bid alone reaches sell orders
+    feed( bbo, 13, 13, NAN );
+    feed( bbo, 13, 13, NAN );
+    feed( bbo, 13, 13, NAN );
+    if( not sellLimitBBO->IsExecuted() or sellLimitBBO->priceExecuted != 13 )
+      Rcout << "2.5 limit not executed by bid - " << ++errors << std::endl;
+
+    if( errors == 0 ) {
+      Rcout << "Test 11 - PASSED!" << std::endl;
+    } else {
+      Rcout << "Test 11 - FAILED! Errors: " << errors << std::endl;
+    }
+    return( errors );
+
+  };
+  int test_12() {
+    Rcout << "Test 12 - ProcessorMulti - Lazy Clocks" << std::endl;
+
+    int errors = 0;
+
+    // 3 symbols quoted in turns, first symbol often has no bid
+    int n = 3;
+    std::vector< double > time, price, bid, ask;
+    std::vector< int > volume, symbols;
+    std::vector< double > last( n, 100 );
+    for( int i = 0; i < 6000; i++ ) {
+      int s = ( i * 7 ) % 11 % n;
+      last[s] += ( ( i * 37 ) % 13 - 6 ) * 0.01;
+      time   .push_back( i * 5. );
+      price  .push_back( last[s] );
+      bid    .push_back( s == 0 and i % 3 != 0 ? NAN : last[s] - 0.01 );
+      ask    .push_back( last[s] + 0.01 );
+      volume .push_back( 1 );
+      symbols.push_back( s );
+    }
+    Ticks ticks( time.size(), time.data(), price.data(), volume.data(), bid.data(), ask.data(), nullptr );
+    ticks.SetTimeZone( "UTC" );
+
+    // buys below and sells above last close with resting limit orders
+    auto setup = []( Processor* bt, std::map< Processor*, int >& idTrade ) {
+      bt->SetExecutionType( ExecutionType::BBO );
+      bt->onCandle = [bt,&idTrade]( Candle candle ) {
+        if( not bt->GetLiveOrders().empty() ) return;
+        if( bt->GetPosition() == 0 ) bt->SendOrder( new Order( OrderSide::BUY , OrderType::LIMIT, candle.close - 0.02, "long" , ++idTrade[bt] ) );
+        if( bt->GetPosition() >  0 ) bt->SendOrder( new Order( OrderSide::SELL, OrderType::LIMIT, candle.close + 0.02, "close",   idTrade[bt] ) );
+      };
+    };
+
+    std::map< Processor*, int > idTrade;
+
+    ProcessorMulti multi( 60, n );
+    for( int p = 0; p < n; p++ ) setup( multi.Get( p ), idTrade );
+    multi.FeedChunk( ticks.Slice( 0, 2500 ), std::vector< int >( symbols.begin(), symbols.begin() + 2500 ) );
+    multi.FeedChunk( ticks.Slice( 2500, 6000 ), std::vector< int >( symbols.begin() + 2500, symbols.end() ) );
+    multi.Finalize();
+
+    // every processor fed every tick, ticks of other symbols as system ticks
+    std::vector< std::unique_ptr< Processor > > everyTick;
+    for( int p = 0; p < n; p++ ) {
+      everyTick.emplace_back( new Processor( 60 ) );
+      setup( everyTick[p].get(), idTrade );
+    }
+    Tick tick;
+    for( std::size_t i = 0; i < ticks.size(); i++ ) {
+      for( int p = 0; p < n; p++ ) {
+        if( symbols[i] == p ) {
+          ticks.Get( i, tick );
+          tick.system = false;
+        } else {
+          tick.time   = time[i];
+          tick.price  = NAN;
+          tick.volume = 0;
+          tick.system = true;
+        }
+        tick.id = i;
+        everyTick[p]->Feed( tick );
+      }
+    }
+    for( auto& bt: everyTick ) bt->Finalize();
+
+    for( int p = 0; p < n; p++ ) {
+      auto& a = multi.Get( p )->ordersProcessed;
+      auto& b = everyTick[p]->ordersProcessed;
+      bool isSame = a.size() == b.size();
+      for( std::size_t i = 0; isSame and i < a.size(); i++ ) isSame = a[i]->idProcessed == b[i]->idProcessed and a[i]->timeExecuted == b[i]->timeExecuted;
+      if( not isSame )
+        Rcout << "1." << p + 1 << " orders processed differ - " << ++errors << std::endl;
+
+      Statistics& s = multi.Get( p )->statistics;
+      Statistics& e = everyTick[p]->statistics;
+      if( s.nTradesTotal != e.nTradesTotal or s.totalPnl != e.totalPnl or s.maxDrawDown != e.maxDrawDown or s.testEnd != e.testEnd )
+        Rcout << "2." << p + 1 << " statistics differ - " << ++errors << std::endl;
+    }
+    if( multi.Get( 0 )->statistics.nTradesTotal < 10 )
+      Rcout << "3.  strategy not tested - " << ++errors << std::endl;
+
+    if( errors == 0 ) {
+      Rcout << "Test 12 - PASSED!" << std::endl;
+    } else {
+      Rcout << "Test 12 - FAILED! Errors: " << errors << std::endl;
+    }
+    return( errors );
+
+  };
+  int test_13() {
+    Rcout << "Test 13 - Indicators - Time Window" << std::endl;
+
+    int errors = 0;
+
+    // irregular times with repeated ones and gaps longer than window
+    std::vector< double > time, x, y;
+    double t = 0;
+    for( int i = 0; i < 3000; i++ ) {
+      t += i % 500 == 0 ? 100 : ( i * 37 ) % 11 * 0.7;
+      time.push_back( t );
+      x.push_back( ( i * 29 ) % 17 - 8 + i * 0.01 );
+      y.push_back( ( i * 13 ) % 7 + x.back() * 0.5 );
+    }
+
+    SmaTime sma( 30 );
+    RollSdTime sd( 30 );
+    RollLinRegTime linReg( 30 ), linRegExpected( 30 );
+    RollRangeTime range( 30, 0.25 ), rangeExpected( 30, 0.25 );
+
+    auto eq = []( double a, double b ) { return a == b or ( std::isnan( a ) and std::isnan( b ) ); };
+
+    int nRejected = 0;
+    bool isLinRegSame = true, isRangeSame = true;
+    for( std::size_t i = 0; i < time.size(); i++ ) {
+      // ticks back in time are rejected and must not change indicators
+      if( i % 100 == 50 ) {
+        try { sma   .Add( time[i - 1] - 1, 1e6 ); } catch( std::invalid_argument& e ) { nRejected++; }
+        try { sd    .Add( time[i - 1] - 1, 1e6 ); } catch( std::invalid_argument& e ) { nRejected++; }
+        try { linReg.Add( time[i - 1] - 1, std::make_pair( 1e6, 1e6 ) ); } catch( std::invalid_argument& e ) { nRejected++; }
+        try { range .Add( time[i - 1] - 1, -1e6 ); } catch( std::invalid_argument& e ) { nRejected++; }
+      }
+      sma.Add( time[i], x[i] );
+      sd .Add( time[i], x[i] );
+      linReg        .Add( time[i], std::make_pair( x[i], y[i] ) );
+      linRegExpected.Add( time[i], std::make_pair( x[i], y[i] ) );
+      range         .Add( time[i], x[i] );
+      rangeExpected .Add( time[i], x[i] );
+
+      LinRegCoeffs a = linReg.GetValue(), b = linRegExpected.GetValue();
+      if( linReg.IsFormed() and not ( eq( a.alpha, b.alpha ) and eq( a.beta, b.beta ) and eq( a.r, b.r ) ) ) isLinRegSame = false;
+      Range c = range.GetValue(), d = rangeExpected.GetValue();
+      if( range.IsFormed() and not ( eq( c.min, d.min ) and eq( c.max, d.max ) and eq( c.quantile, d.quantile ) ) ) isRangeSame = false;
+    }
+    if( nRejected != 4 * 30 )
+      Rcout << "1.  decreasing time not rejected - " << ++errors << std::endl;
+
+    auto isSame = [&eq]( const std::vector< double >& a, const std::vector< double >& b ) {
+      if( a.size() != b.size() ) return false;
+      for( std::size_t i = 0; i < a.size(); i++ ) if( not eq( a[i], b[i] ) ) return false;
+      return true;
+    };
+
+    std::vector< double > bulk( time.size() );
+    sma.Bulk( time.data(), x.data(), time.size(), bulk.data() );
+    if( not isSame( sma.GetHistory(), bulk ) )
+      Rcout << "2.1 SmaTime Add and Bulk differ - " << ++errors << std::endl;
+    sd.Bulk( time.data(), x.data(), time.size(), bulk.data() );
+    if( not isSame( sd.GetHistory(), bulk ) )
+      Rcout << "2.2 RollSdTime Add and Bulk differ - " << ++errors << std::endl;
+
+    if( not isLinRegSame )
+      Rcout << "3.1 RollLinRegTime changed by rejected time - " << ++errors << std::endl;
+    if( not isRangeSame )
+      Rcout << "3.2 RollRangeTime changed by rejected time - " << ++errors << std::endl;
+
+    // infinite time is rejected as it would expire every value including itself
+    RollSdTime sdInf( 60 );
+    sdInf.Add( 0, 1 );
+    try { sdInf.Add( INFINITY, 2 ); Rcout << "4.1 infinite time accepted by Add - " << ++errors << std::endl; } catch( std::invalid_argument& e ) {}
+    std::vector< double > timeInf = { 0, INFINITY };
+    try { sma.Bulk( timeInf.data(), x.data(), 2, bulk.data() ); Rcout << "4.2 infinite time accepted by Bulk - " << ++errors << std::endl; } catch( std::invalid_argument& e ) {}
+
+    // seconds below time precision keep the last value only
+    SmaTime smaTiny( 1e-9 );
+    RollSdTime sdTiny( 1e-9 );
+    std::vector< double > timeTiny = { 1.7e9, 1.7e9, 1.7e9 + 1, 1.7e9 + 1 };
+    for( std::size_t i = 0; i < timeTiny.size(); i++ ) {
+      smaTiny.Add( timeTiny[i], x[i] );
+      sdTiny .Add( timeTiny[i], x[i] );
+    }
+    smaTiny.Bulk( timeTiny.data(), x.data(), timeTiny.size(), bulk.data() );
+    bulk.resize( timeTiny.size() );
+    if( not isSame( smaTiny.GetHistory(), bulk ) or std::abs( bulk.back() - x[3] ) > 1e-9 )
+      Rcout << "4.3 SmaTime wrong on seconds below time precision - " << ++errors << std::endl;
+    sdTiny.Bulk( timeTiny.data(), x.data(), timeTiny.size(), bulk.data() );
+    if( not isSame( sdTiny.GetHistory(), bulk ) )
+      Rcout << "4.4 RollSdTime wrong on seconds below time precision - " << ++errors << std::endl;
+
+    if( errors == 0 ) {
+      Rcout << "Test 13 - PASSED!" << std::endl;
+    } else {
+      Rcout << "Test 13 - FAILED! Errors: " << errors << std::endl;
+    }
+    return( errors );
+
+  };
 public:
   bool test() {
     int errors = 0;
@@ -450,6 +1139,14 @@ public:
     errors += test_03();
     errors += test_04();
     errors += test_05();
+    errors += test_06();
+    errors += test_07();
+    errors += test_08();
+    errors += test_09();
+    errors += test_10();
+    errors += test_11();
+    errors += test_12();
+    errors += test_13();
     Rcout << "-----------------------------------------" << std::endl;
     if( errors == 0 ) {
       Rcout << "Tests   - PASSED!" << std::endl;
@@ -16,22 +16,69 @@
 // along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
 
 #include "../inst/include/Indicators/Sma.h"
+#include "../inst/include/Indicators/SmaBank.h"
+#include "../inst/include/Indicators/SmaTime.h"
 
 //' Simple Moving Average
 //'
 //' @param x numeric vectors
-//' @param n window size
+//' @param n window size, window sizes for sma_bank
+//' @param time numeric vector of value times in seconds, e.g. \code{POSIXct}, must be finite and not decrease
+//' @param seconds window length in seconds for \code{_time} version
 //' @family technical indicators
+//' @return sma and sma_time return numeric vector
+//' \cr sma_bank returns data.table with column \code{sma_<n>} for each window size
 //' @description Simple moving average also called SMA is the most popular indicator. It shows the average of n past values. Can be used for time series smoothing.
+//' \cr sma_bank calculates averages of several window sizes in one pass.
+//' \cr sma_time averages values of last \code{seconds} of irregular time series such as ticks.
 //' @export
 // [[Rcpp::export]]
-std::vector<double> sma( Rcpp::NumericVector x, int n ) {
+Rcpp::NumericVector sma( Rcpp::NumericVector x, int n ) {
 
   Sma sma( n );
 
-  for( auto i = 0; i < x.size(); i++ ) sma.Add( x[i] );
+  Rcpp::NumericVector values( Rcpp::no_init( x.size() ) );
+  sma.Bulk( x.begin(), x.size(), values.begin() );
 
-  return sma.GetHistory();
+  return values;
+
+}
+//' @rdname sma
+//' @export
+// [[Rcpp::export]]
+Rcpp::List sma_bank( Rcpp::NumericVector x, std::vector< int > n ) {
+
+  SmaBank bank( n );
+
+  std::vector< Rcpp::NumericVector > columns;
+  std::vector< double* > out;
+  columns.reserve( n.size() );
+  for( std::size_t i = 0; i < n.size(); i++ ) {
+
+    columns.push_back( Rcpp::NumericVector( Rcpp::no_init( x.size() ) ) );
+    out.push_back( columns.back().begin() );
+
+  }
+  bank.Bulk( x.begin(), x.size(), out );
+
+  ListBuilder history;
+  history.AsDataTable();
+  for( std::size_t i = 0; i < n.size(); i++ ) history.Add( "sma_" + std::to_string( n[i] ), columns[i] );
+  return history;
+
+}
+//' @rdname sma
+//' @export
+// [[Rcpp::export]]
+Rcpp::NumericVector sma_time( Rcpp::NumericVector x, Rcpp::NumericVector time, double seconds ) {
+
+  SmaTime sma( seconds );
+  if( time.size() != x.size() ) throw std::invalid_argument( "x and time must have the same length" );
+
+  Rcpp::NumericVector values( Rcpp::no_init( x.size() ) );
+  sma.Bulk( time.begin(), x.begin(), x.size(), values.begin() );
+
+  return values;
 
 }
 //' @name sma
@@ -0,0 +1,81 @@
+// Copyright (C) 2016 Stanislav Kovalevsky
+//
+// This file is part of QuantTools.
+//
+// QuantTools is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// QuantTools is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with QuantTools. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Rcpp.h>
+#include "../inst/include/BackTest/TickFile.h"
+#include "../inst/include/ListBuilder.h"
+#include "../inst/include/CppToR.h"
+
+//' Binary tick files
+//'
+//' @name tick_file
+//' @param ticks read 'Ticks' section in \link{Processor}
+//' @param file tick file path
+//' @param from,to text dates in format \code{"YYYY-mm-dd"}, empty for no limit
+//' @description Store ticks in columnar binary file and read them back without decompression.
+//' @details File contains \code{time, price, volume} and optionally \code{bid, ask} columns in native byte order and index of days (UTC).
+//' \code{write_ticks} adds ticks to file, ticks already stored within time span of new ticks are replaced. If only stored or only new ticks have \code{bid, ask} columns they are kept and filled with \code{NA} for the rest. \cr
+//' \code{read_ticks} returns data.table of ticks between \code{from} and \code{to} dates inclusive. \cr
+//' \code{tick_file_dates} returns dates stored. \cr
+//' In C++ \code{TickFile( file ).Get( from, to )} memory maps file and returns ticks without copying, ready for \code{Processor::Feed}.
+//' \code{to_candles} accepts tick file path as well.
+//' @rdname tick_file
+//' @export
+// [[Rcpp::export]]
+void write_ticks( Rcpp::DataFrame ticks, std::string file ) {
+
+  TickFile::Write( file, Ticks( ticks ) );
+
+}
+
+//' @rdname tick_file
+//' @export
+// [[Rcpp::export]]
+Rcpp::List read_ticks( std::string file, std::string from = "", std::string to = "" ) {
+
+  Ticks ticks = TickFile( file ).Get( from.empty() ? INT32_MIN : TickFile::ToDate( from ), to.empty() ? INT32_MAX : TickFile::ToDate( to ) );
+
+  auto n = ticks.size();
+
+  Rcpp::NumericVector time  ( ticks.GetTime()  , ticks.GetTime()   + n );
+  Rcpp::NumericVector price ( ticks.GetPrice() , ticks.GetPrice()  + n );
+  Rcpp::IntegerVector volume( ticks.GetVolume(), ticks.GetVolume() + n );
+
+  time.attr( "class" ) = Rcpp::CharacterVector::create( "POSIXct", "POSIXt" );
+  time.attr( "tzone" ) = Rcpp::CharacterVector::create( "UTC" );
+
+  ListBuilder output;
+  output.AsDataTable()
+    .Add( "time"  , time   )
+    .Add( "price" , price  )
+    .Add( "volume", volume );
+
+  if( ticks.HasBid() ) output.Add( "bid", Rcpp::NumericVector( ticks.GetBid(), ticks.GetBid() + n ) );
+  if( ticks.HasAsk() ) output.Add( "ask", Rcpp::NumericVector( ticks.GetAsk(), ticks.GetAsk() + n ) );
+
+  return output;
+
+}
+
+//' @rdname tick_file
+//' @export
+// [[Rcpp::export]]
+Rcpp::IntegerVector tick_file_dates( std::string file ) {
+
+  return IntToDate( TickFile( file ).GetDates() );
+
+}
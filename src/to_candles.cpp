@@ -19,46 +19,67 @@
 #include <vector>
 #include "../inst/include/BackTest/Candle.h"
 #include "../inst/include/BackTest/Tick.h"
+#include "../inst/include/BackTest/TickFile.h"
 #include "../inst/include/ListBuilder.h"
 #include "../inst/include/CppToR.h"
 
 //' Convert ticks to candles
 //'
 //' @name to_candles
-//' @param ticks read 'Ticks' section in \link{Processor}
+//' @param ticks read 'Ticks' section in \link{Processor} or path to \link{tick_file}
 //' @param timeframe candle timeframe in seconds
 //' @return data.table with columns \code{time, open, high, low, close, volume, id}. Where \code{id} is row number of last tick in candle. \cr
 //' Note: last candle is always omitted.
 //' @rdname to_candles
 //' @export
 // [[Rcpp::export]]
-Rcpp::List to_candles( Rcpp::DataFrame ticks, int timeframe ) {
+Rcpp::List to_candles( SEXP ticks, int timeframe ) {
 
-  Rcpp::StringVector names = ticks.attr( "names" );
+  Rcpp::NumericVector  times;
+  Rcpp::NumericVector  prices;
+  Rcpp::IntegerVector  volumes;
+  Rcpp::RObject        tzone;
 
-  bool hasTime   = std::find( names.begin(), names.end(), "time"   ) != names.end();
-  bool hasPrice  = std::find( names.begin(), names.end(), "price"  ) != names.end();
-  bool hasVolume = std::find( names.begin(), names.end(), "volume" ) != names.end();
+  // both are read without copying
+  Ticks data;
 
-  if( !hasTime   ) throw std::invalid_argument( "ticks must contain 'time' column"   );
-  if( !hasPrice  ) throw std::invalid_argument( "ticks must contain 'price' column"  );
-  if( !hasVolume ) throw std::invalid_argument( "ticks must contain 'volume' column" );
+  if( Rf_isString( ticks ) ) {
 
-  Rcpp::NumericVector  times   = ticks[ "time"   ];
-  Rcpp::NumericVector  prices  = ticks[ "price"  ];
-  Rcpp::IntegerVector  volumes = ticks[ "volume" ];
+    data  = TickFile( Rcpp::as< std::string >( ticks ) ).Get();
+    tzone = Rcpp::CharacterVector::create( "UTC" );
+
+  } else {
+
+    Rcpp::DataFrame df( ticks );
+
+    Rcpp::StringVector names = df.attr( "names" );
+
+    bool hasTime   = std::find( names.begin(), names.end(), "time"   ) != names.end();
+    bool hasPrice  = std::find( names.begin(), names.end(), "price"  ) != names.end();
+    bool hasVolume = std::find( names.begin(), names.end(), "volume" ) != names.end();
+
+    if( !hasTime   ) throw std::invalid_argument( "ticks must contain 'time' column"   );
+    if( !hasPrice  ) throw std::invalid_argument( "ticks must contain 'price' column"  );
+    if( !hasVolume ) throw std::invalid_argument( "ticks must contain 'volume' column" );
+
+    times   = df[ "time"   ];
+    prices  = df[ "price"  ];
+    volumes = df[ "volume" ];
+    tzone   = times.attr( "tzone" );
+
+    data = Ticks( times.size(), times.begin(), prices.begin(), volumes.begin(), nullptr, nullptr, nullptr );
+
+  }
 
   Candle candle( timeframe );
   Candle candleProcessing( timeframe );
   std::vector<Candle> candles;
 
-  for( int id = 0; id < times.size(); id++ ) {
+  Tick tick;
+
+  for( std::size_t id = 0; id < data.size(); id++ ) {
 
-    Tick tick;
-    tick.id = (int)id;
-    tick.time = times[id];
-    tick.price = prices[id];
-    tick.volume =  volumes[id];
+    data.Get( id, tick );
 
     bool startOver = candleProcessing.time != floor( tick.time / timeframe ) * timeframe + timeframe;
 
@@ -96,7 +117,7 @@ Rcpp::List to_candles( Rcpp::DataFrame ticks, int timeframe ) {
   }
 
   time.attr( "class" ) = Rcpp::CharacterVector::create( "POSIXct", "POSIXt" );
-  time.attr( "tzone" ) = times.attr( "tzone" );
+  time.attr( "tzone" ) = tzone;
 
   Rcpp::List output = ListBuilder().AsDataTable()
     .Add( "time"  , time   )